@@ -36,5 +36,7 @@ public class BPixelStreamingGCP : ModuleRules
 				"UnrealEd",
 				"Blutility"
 			});
+
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
 	}
 }
\ No newline at end of file
@@ -0,0 +1,608 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "PSGCPCodec.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#define PSGCP_CODEC_X86 1
+#else
+#define PSGCP_CODEC_X86 0
+#endif
+
+#if PSGCP_CODEC_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define PSGCP_TARGET_SSSE3
+#define PSGCP_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define PSGCP_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define PSGCP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+	const ANSICHAR HexDigitsLower[] = "0123456789abcdef";
+	const ANSICHAR HexDigitsUpper[] = "0123456789ABCDEF";
+	const ANSICHAR Base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	struct FPSGCPDecodeTables
+	{
+		int8 Hex[256];
+		int8 Base64[256];
+
+		FPSGCPDecodeTables()
+		{
+			for (int32 i = 0; i < 256; i++)
+			{
+				Hex[i] = -1;
+				Base64[i] = -1;
+			}
+			for (int32 i = 0; i < 16; i++)
+			{
+				Hex[(uint8)HexDigitsLower[i]] = (int8)i;
+				Hex[(uint8)HexDigitsUpper[i]] = (int8)i;
+			}
+			for (int32 i = 0; i < 64; i++)
+			{
+				Base64[(uint8)Base64Alphabet[i]] = (int8)i;
+			}
+		}
+	};
+
+	const FPSGCPDecodeTables& GetDecodeTables()
+	{
+		static const FPSGCPDecodeTables Tables;
+		return Tables;
+	}
+
+	struct FPSGCPCpuFeatures
+	{
+		bool bSSSE3 = false;
+		bool bAVX2 = false;
+
+		FPSGCPCpuFeatures()
+		{
+#if PSGCP_CODEC_X86
+			uint32 Leaf1[4] = { 0, 0, 0, 0 };
+			uint32 Leaf7[4] = { 0, 0, 0, 0 };
+			uint64 EnabledStates = 0;
+#if defined(_MSC_VER) && !defined(__clang__)
+			int32 Info[4];
+			__cpuid(Info, 0);
+			const int32 MaxLeaf = Info[0];
+			__cpuid(Info, 1);
+			FMemory::Memcpy(Leaf1, Info, sizeof(Leaf1));
+			if (MaxLeaf >= 7)
+			{
+				__cpuidex(Info, 7, 0);
+				FMemory::Memcpy(Leaf7, Info, sizeof(Leaf7));
+			}
+			const bool bOSXSave = (Leaf1[2] & (1u << 27)) != 0;
+			if (bOSXSave)
+			{
+				EnabledStates = _xgetbv(0);
+			}
+#else
+			const uint32 MaxLeaf = __get_cpuid_max(0, nullptr);
+			__get_cpuid(1, &Leaf1[0], &Leaf1[1], &Leaf1[2], &Leaf1[3]);
+			if (MaxLeaf >= 7)
+			{
+				__get_cpuid_count(7, 0, &Leaf7[0], &Leaf7[1], &Leaf7[2], &Leaf7[3]);
+			}
+			const bool bOSXSave = (Leaf1[2] & (1u << 27)) != 0;
+			if (bOSXSave)
+			{
+				uint32 EAX = 0;
+				uint32 EDX = 0;
+				__asm__ volatile("xgetbv" : "=a"(EAX), "=d"(EDX) : "c"(0));
+				EnabledStates = ((uint64)EDX << 32) | EAX;
+			}
+#endif
+			const bool bAVX = (Leaf1[2] & (1u << 28)) != 0;
+			bSSSE3 = (Leaf1[2] & (1u << 9)) != 0;
+			bAVX2 = bSSSE3 && bAVX && bOSXSave && (EnabledStates & 0x6) == 0x6 && (Leaf7[1] & (1u << 5)) != 0;
+#endif
+		}
+	};
+
+	const FPSGCPCpuFeatures& GetCpuFeatures()
+	{
+		static const FPSGCPCpuFeatures Features;
+		return Features;
+	}
+
+	EPSGCPCodecKernel ResolveKernel(EPSGCPCodecKernel Kernel)
+	{
+		const FPSGCPCpuFeatures& Features = GetCpuFeatures();
+		if ((Kernel == EPSGCPCodecKernel::Auto || Kernel == EPSGCPCodecKernel::AVX2) && Features.bAVX2) return EPSGCPCodecKernel::AVX2;
+		if (Kernel != EPSGCPCodecKernel::Scalar && Features.bSSSE3) return EPSGCPCodecKernel::SSSE3;
+		return EPSGCPCodecKernel::Scalar;
+	}
+
+	/**
+	 * Block kernels only process whole blocks of valid input and return how much they consumed;
+	 * the scalar code finishes the tail and reports errors.
+	 */
+#if PSGCP_CODEC_X86
+	PSGCP_TARGET_SSSE3 int64 HexEncodeSSSE3(const uint8* Src, int64 Count, ANSICHAR* Dst, bool bUpperCase)
+	{
+		const __m128i Digits = _mm_loadu_si128((const __m128i*)(bUpperCase ? HexDigitsUpper : HexDigitsLower));
+		const __m128i LowMask = _mm_set1_epi8(0x0F);
+
+		int64 Consumed = 0;
+		for (; Count - Consumed >= 16; Consumed += 16)
+		{
+			const __m128i Input = _mm_loadu_si128((const __m128i*)(Src + Consumed));
+			const __m128i High = _mm_shuffle_epi8(Digits, _mm_and_si128(_mm_srli_epi16(Input, 4), LowMask));
+			const __m128i Low = _mm_shuffle_epi8(Digits, _mm_and_si128(Input, LowMask));
+			_mm_storeu_si128((__m128i*)(Dst + Consumed * 2), _mm_unpacklo_epi8(High, Low));
+			_mm_storeu_si128((__m128i*)(Dst + Consumed * 2 + 16), _mm_unpackhi_epi8(High, Low));
+		}
+		return Consumed;
+	}
+
+	PSGCP_TARGET_AVX2 int64 HexEncodeAVX2(const uint8* Src, int64 Count, ANSICHAR* Dst, bool bUpperCase)
+	{
+		const __m256i Digits = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(bUpperCase ? HexDigitsUpper : HexDigitsLower)));
+		const __m256i LowMask = _mm256_set1_epi8(0x0F);
+
+		int64 Consumed = 0;
+		for (; Count - Consumed >= 32; Consumed += 32)
+		{
+			const __m256i Input = _mm256_loadu_si256((const __m256i*)(Src + Consumed));
+			const __m256i High = _mm256_shuffle_epi8(Digits, _mm256_and_si256(_mm256_srli_epi16(Input, 4), LowMask));
+			const __m256i Low = _mm256_shuffle_epi8(Digits, _mm256_and_si256(Input, LowMask));
+			const __m256i Interleaved0 = _mm256_unpacklo_epi8(High, Low);
+			const __m256i Interleaved1 = _mm256_unpackhi_epi8(High, Low);
+			_mm256_storeu_si256((__m256i*)(Dst + Consumed * 2), _mm256_permute2x128_si256(Interleaved0, Interleaved1, 0x20));
+			_mm256_storeu_si256((__m256i*)(Dst + Consumed * 2 + 32), _mm256_permute2x128_si256(Interleaved0, Interleaved1, 0x31));
+		}
+		return Consumed;
+	}
+
+	PSGCP_TARGET_SSSE3 __m128i HexDecodeNibblesSSSE3(__m128i Input, __m128i& InOutValid)
+	{
+		const __m128i Digit = _mm_sub_epi8(Input, _mm_set1_epi8('0'));
+		const __m128i Letter = _mm_sub_epi8(_mm_or_si128(Input, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+		const __m128i bDigit = _mm_cmpeq_epi8(_mm_min_epu8(Digit, _mm_set1_epi8(9)), Digit);
+		const __m128i bLetter = _mm_cmpeq_epi8(_mm_min_epu8(Letter, _mm_set1_epi8(5)), Letter);
+		InOutValid = _mm_and_si128(InOutValid, _mm_or_si128(bDigit, bLetter));
+		return _mm_or_si128(_mm_and_si128(bDigit, Digit), _mm_and_si128(bLetter, _mm_add_epi8(Letter, _mm_set1_epi8(10))));
+	}
+
+	PSGCP_TARGET_SSSE3 int64 HexDecodeSSSE3(const ANSICHAR* Src, int64 Count, uint8* Dst)
+	{
+		const __m128i PairWeights = _mm_set1_epi16(0x0110);
+
+		int64 Consumed = 0;
+		for (; Count - Consumed >= 32; Consumed += 32)
+		{
+			__m128i Valid = _mm_set1_epi8(-1);
+			const __m128i Nibbles0 = HexDecodeNibblesSSSE3(_mm_loadu_si128((const __m128i*)(Src + Consumed)), Valid);
+			const __m128i Nibbles1 = HexDecodeNibblesSSSE3(_mm_loadu_si128((const __m128i*)(Src + Consumed + 16)), Valid);
+			if (_mm_movemask_epi8(Valid) != 0xFFFF) break;
+
+			const __m128i Bytes = _mm_packus_epi16(_mm_maddubs_epi16(Nibbles0, PairWeights), _mm_maddubs_epi16(Nibbles1, PairWeights));
+			_mm_storeu_si128((__m128i*)(Dst + Consumed / 2), Bytes);
+		}
+		return Consumed;
+	}
+
+	PSGCP_TARGET_AVX2 __m256i HexDecodeNibblesAVX2(__m256i Input, __m256i& InOutValid)
+	{
+		const __m256i Digit = _mm256_sub_epi8(Input, _mm256_set1_epi8('0'));
+		const __m256i Letter = _mm256_sub_epi8(_mm256_or_si256(Input, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+		const __m256i bDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(Digit, _mm256_set1_epi8(9)), Digit);
+		const __m256i bLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(Letter, _mm256_set1_epi8(5)), Letter);
+		InOutValid = _mm256_and_si256(InOutValid, _mm256_or_si256(bDigit, bLetter));
+		return _mm256_or_si256(_mm256_and_si256(bDigit, Digit), _mm256_and_si256(bLetter, _mm256_add_epi8(Letter, _mm256_set1_epi8(10))));
+	}
+
+	PSGCP_TARGET_AVX2 int64 HexDecodeAVX2(const ANSICHAR* Src, int64 Count, uint8* Dst)
+	{
+		const __m256i PairWeights = _mm256_set1_epi16(0x0110);
+
+		int64 Consumed = 0;
+		for (; Count - Consumed >= 64; Consumed += 64)
+		{
+			__m256i Valid = _mm256_set1_epi8(-1);
+			const __m256i Nibbles0 = HexDecodeNibblesAVX2(_mm256_loadu_si256((const __m256i*)(Src + Consumed)), Valid);
+			const __m256i Nibbles1 = HexDecodeNibblesAVX2(_mm256_loadu_si256((const __m256i*)(Src + Consumed + 32)), Valid);
+			if (_mm256_movemask_epi8(Valid) != -1) break;
+
+			//packus works per 128 bit lane; the permute restores the byte order.
+			const __m256i Bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(Nibbles0, PairWeights), _mm256_maddubs_epi16(Nibbles1, PairWeights));
+			_mm256_storeu_si256((__m256i*)(Dst + Consumed / 2), _mm256_permute4x64_epi64(Bytes, 0xD8));
+		}
+		return Consumed;
+	}
+
+	//Splits 12 input bytes into 16 six bit indices, then maps indices to the alphabet (Mula & Lemire).
+	PSGCP_TARGET_SSSE3 __m128i Base64EncodeBlockSSSE3(__m128i Input)
+	{
+		Input = _mm_shuffle_epi8(Input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		const __m128i Bits0 = _mm_mulhi_epu16(_mm_and_si128(Input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+		const __m128i Bits1 = _mm_mullo_epi16(_mm_and_si128(Input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+		const __m128i Indices = _mm_or_si128(Bits0, Bits1);
+
+		const __m128i ShiftLUT = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+		__m128i Reduced = _mm_subs_epu8(Indices, _mm_set1_epi8(51));
+		Reduced = _mm_or_si128(Reduced, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), Indices), _mm_set1_epi8(13)));
+		return _mm_add_epi8(_mm_shuffle_epi8(ShiftLUT, Reduced), Indices);
+	}
+
+	PSGCP_TARGET_SSSE3 int64 Base64EncodeSSSE3(const uint8* Src, int64 Count, ANSICHAR* Dst)
+	{
+		//Each block reads 16 bytes but consumes 12.
+		int64 Consumed = 0;
+		int64 Written = 0;
+		for (; Count - Consumed >= 16; Consumed += 12, Written += 16)
+		{
+			_mm_storeu_si128((__m128i*)(Dst + Written), Base64EncodeBlockSSSE3(_mm_loadu_si128((const __m128i*)(Src + Consumed))));
+		}
+		return Consumed;
+	}
+
+	PSGCP_TARGET_AVX2 __m256i Base64EncodeBlockAVX2(__m256i Input)
+	{
+		Input = _mm256_shuffle_epi8(Input, _mm256_set_epi8(
+			10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+			10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		const __m256i Bits0 = _mm256_mulhi_epu16(_mm256_and_si256(Input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+		const __m256i Bits1 = _mm256_mullo_epi16(_mm256_and_si256(Input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+		const __m256i Indices = _mm256_or_si256(Bits0, Bits1);
+
+		const __m256i ShiftLUT = _mm256_setr_epi8(
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+		__m256i Reduced = _mm256_subs_epu8(Indices, _mm256_set1_epi8(51));
+		Reduced = _mm256_or_si256(Reduced, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), Indices), _mm256_set1_epi8(13)));
+		return _mm256_add_epi8(_mm256_shuffle_epi8(ShiftLUT, Reduced), Indices);
+	}
+
+	PSGCP_TARGET_AVX2 int64 Base64EncodeAVX2(const uint8* Src, int64 Count, ANSICHAR* Dst)
+	{
+		//Each 128 bit lane gets its own 12 input bytes.
+		int64 Consumed = 0;
+		int64 Written = 0;
+		for (; Count - Consumed >= 32; Consumed += 24, Written += 32)
+		{
+			const __m256i Input = _mm256_inserti128_si256(
+				_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(Src + Consumed))),
+				_mm_loadu_si128((const __m128i*)(Src + Consumed + 12)), 1);
+			_mm256_storeu_si256((__m256i*)(Dst + Written), Base64EncodeBlockAVX2(Input));
+		}
+		return Consumed;
+	}
+
+	PSGCP_TARGET_SSSE3 int64 Base64DecodeSSSE3(const ANSICHAR* Src, int64 Count, uint8* Dst)
+	{
+		const __m128i LUTLow = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m128i LUTHigh = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m128i LUTRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i Mask2F = _mm_set1_epi8(0x2F);
+
+		//Each block reads 16 characters and writes 16 bytes of which 12 are valid; the margin keeps the extra 4 inside the caller's buffer.
+		int64 Consumed = 0;
+		int64 Written = 0;
+		for (; Count - Consumed >= 24; Consumed += 16, Written += 12)
+		{
+			__m128i Input = _mm_loadu_si128((const __m128i*)(Src + Consumed));
+			const __m128i HighNibbles = _mm_and_si128(_mm_srli_epi32(Input, 4), Mask2F);
+			const __m128i LowNibbles = _mm_and_si128(Input, Mask2F);
+			const __m128i High = _mm_shuffle_epi8(LUTHigh, HighNibbles);
+			const __m128i Low = _mm_shuffle_epi8(LUTLow, LowNibbles);
+			if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(Low, High), _mm_setzero_si128())) != 0) break;
+
+			const __m128i Roll = _mm_shuffle_epi8(LUTRoll, _mm_add_epi8(_mm_cmpeq_epi8(Input, Mask2F), HighNibbles));
+			Input = _mm_add_epi8(Input, Roll);
+
+			const __m128i Merged = _mm_madd_epi16(_mm_maddubs_epi16(Input, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+			_mm_storeu_si128((__m128i*)(Dst + Written), _mm_shuffle_epi8(Merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+		}
+		return Consumed;
+	}
+
+	PSGCP_TARGET_AVX2 int64 Base64DecodeAVX2(const ANSICHAR* Src, int64 Count, uint8* Dst)
+	{
+		const __m256i LUTLow = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+		const __m256i LUTHigh = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+		const __m256i LUTRoll = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+		const __m256i Mask2F = _mm256_set1_epi8(0x2F);
+		const __m256i PackLanes = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+		//Each block reads 32 characters and writes 32 bytes of which 24 are valid.
+		int64 Consumed = 0;
+		int64 Written = 0;
+		for (; Count - Consumed >= 45; Consumed += 32, Written += 24)
+		{
+			__m256i Input = _mm256_loadu_si256((const __m256i*)(Src + Consumed));
+			const __m256i HighNibbles = _mm256_and_si256(_mm256_srli_epi32(Input, 4), Mask2F);
+			const __m256i LowNibbles = _mm256_and_si256(Input, Mask2F);
+			const __m256i High = _mm256_shuffle_epi8(LUTHigh, HighNibbles);
+			const __m256i Low = _mm256_shuffle_epi8(LUTLow, LowNibbles);
+			if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(Low, High), _mm256_setzero_si256())) != 0) break;
+
+			const __m256i Roll = _mm256_shuffle_epi8(LUTRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(Input, Mask2F), HighNibbles));
+			Input = _mm256_add_epi8(Input, Roll);
+
+			const __m256i Merged = _mm256_madd_epi16(_mm256_maddubs_epi16(Input, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+			const __m256i Packed = _mm256_shuffle_epi8(Merged, PackLanes);
+			_mm256_storeu_si256((__m256i*)(Dst + Written), _mm256_permutevar8x32_epi32(Packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7)));
+		}
+		return Consumed;
+	}
+#endif
+
+	int64 HexEncodeBlocks(EPSGCPCodecKernel Kernel, const uint8* Src, int64 Count, ANSICHAR* Dst, bool bUpperCase)
+	{
+#if PSGCP_CODEC_X86
+		if (Kernel == EPSGCPCodecKernel::AVX2) return HexEncodeAVX2(Src, Count, Dst, bUpperCase);
+		if (Kernel == EPSGCPCodecKernel::SSSE3) return HexEncodeSSSE3(Src, Count, Dst, bUpperCase);
+#endif
+		return 0;
+	}
+
+	int64 HexDecodeBlocks(EPSGCPCodecKernel Kernel, const ANSICHAR* Src, int64 Count, uint8* Dst)
+	{
+#if PSGCP_CODEC_X86
+		if (Kernel == EPSGCPCodecKernel::AVX2) return HexDecodeAVX2(Src, Count, Dst);
+		if (Kernel == EPSGCPCodecKernel::SSSE3) return HexDecodeSSSE3(Src, Count, Dst);
+#endif
+		return 0;
+	}
+
+	int64 Base64EncodeBlocks(EPSGCPCodecKernel Kernel, const uint8* Src, int64 Count, ANSICHAR* Dst)
+	{
+#if PSGCP_CODEC_X86
+		if (Kernel == EPSGCPCodecKernel::AVX2) return Base64EncodeAVX2(Src, Count, Dst);
+		if (Kernel == EPSGCPCodecKernel::SSSE3) return Base64EncodeSSSE3(Src, Count, Dst);
+#endif
+		return 0;
+	}
+
+	int64 Base64DecodeBlocks(EPSGCPCodecKernel Kernel, const ANSICHAR* Src, int64 Count, uint8* Dst)
+	{
+#if PSGCP_CODEC_X86
+		if (Kernel == EPSGCPCodecKernel::AVX2) return Base64DecodeAVX2(Src, Count, Dst);
+		if (Kernel == EPSGCPCodecKernel::SSSE3) return Base64DecodeSSSE3(Src, Count, Dst);
+#endif
+		return 0;
+	}
+
+	void Base64EncodeTriplet(uint8 A, uint8 B, uint8 C, ANSICHAR* Dst)
+	{
+		const uint32 Triplet = ((uint32)A << 16) | ((uint32)B << 8) | C;
+		Dst[0] = Base64Alphabet[(Triplet >> 18) & 0x3F];
+		Dst[1] = Base64Alphabet[(Triplet >> 12) & 0x3F];
+		Dst[2] = Base64Alphabet[(Triplet >> 6) & 0x3F];
+		Dst[3] = Base64Alphabet[Triplet & 0x3F];
+	}
+}
+
+bool PSGCPCodec::IsKernelSupported(EPSGCPCodecKernel Kernel)
+{
+	switch (Kernel)
+	{
+	case EPSGCPCodecKernel::AVX2:
+		return GetCpuFeatures().bAVX2;
+	case EPSGCPCodecKernel::SSSE3:
+		return GetCpuFeatures().bSSSE3;
+	default:
+		return true;
+	}
+}
+
+void PSGCPCodec::HexEncode(const uint8* Src, int64 Count, ANSICHAR* Dst, bool bUpperCase, EPSGCPCodecKernel Kernel)
+{
+	const ANSICHAR* Digits = bUpperCase ? HexDigitsUpper : HexDigitsLower;
+
+	for (int64 i = HexEncodeBlocks(ResolveKernel(Kernel), Src, Count, Dst, bUpperCase); i < Count; i++)
+	{
+		Dst[i * 2] = Digits[Src[i] >> 4];
+		Dst[i * 2 + 1] = Digits[Src[i] & 0x0F];
+	}
+}
+
+bool PSGCPCodec::HexDecode(const ANSICHAR* Src, int64 Count, uint8* Dst, int64& OutWritten, EPSGCPCodecKernel Kernel)
+{
+	FHexDecoder Decoder(Kernel);
+	return Decoder.Update(Src, Count, Dst, OutWritten) && Decoder.Finish();
+}
+
+int64 PSGCPCodec::Base64Encode(const uint8* Src, int64 Count, ANSICHAR* Dst, EPSGCPCodecKernel Kernel)
+{
+	FBase64Encoder Encoder(Kernel);
+	const int64 Written = Encoder.Update(Src, Count, Dst);
+	return Written + Encoder.Finish(Dst + Written);
+}
+
+bool PSGCPCodec::Base64Decode(const ANSICHAR* Src, int64 Count, uint8* Dst, int64& OutWritten, EPSGCPCodecKernel Kernel)
+{
+	FBase64Decoder Decoder(Kernel);
+
+	int64 FinishWritten = 0;
+	if (!Decoder.Update(Src, Count, Dst, OutWritten) || !Decoder.Finish(Dst + OutWritten, FinishWritten))
+	{
+		return false;
+	}
+	OutWritten += FinishWritten;
+	return true;
+}
+
+bool PSGCPCodec::FHexDecoder::Update(const ANSICHAR* Src, int64 Count, uint8* Dst, int64& OutWritten)
+{
+	OutWritten = 0;
+	if (bFailed) return false;
+
+	const int8* Table = GetDecodeTables().Hex;
+
+	int64 Consumed = 0;
+	if (PendingNibble >= 0 && Count > 0)
+	{
+		const int8 Low = Table[(uint8)Src[0]];
+		if (Low < 0)
+		{
+			bFailed = true;
+			return false;
+		}
+		Dst[OutWritten++] = (uint8)((PendingNibble << 4) | Low);
+		PendingNibble = -1;
+		Consumed = 1;
+	}
+
+	const int64 BlockConsumed = HexDecodeBlocks(ResolveKernel(Kernel), Src + Consumed, Count - Consumed, Dst + OutWritten);
+	Consumed += BlockConsumed;
+	OutWritten += BlockConsumed / 2;
+
+	for (; Consumed + 1 < Count; Consumed += 2)
+	{
+		const int8 High = Table[(uint8)Src[Consumed]];
+		const int8 Low = Table[(uint8)Src[Consumed + 1]];
+		if (High < 0 || Low < 0)
+		{
+			bFailed = true;
+			return false;
+		}
+		Dst[OutWritten++] = (uint8)((High << 4) | Low);
+	}
+
+	if (Consumed < Count)
+	{
+		PendingNibble = Table[(uint8)Src[Consumed]];
+		if (PendingNibble < 0)
+		{
+			bFailed = true;
+			return false;
+		}
+	}
+	return true;
+}
+
+int64 PSGCPCodec::FBase64Encoder::Update(const uint8* Src, int64 Count, ANSICHAR* Dst)
+{
+	int64 Consumed = 0;
+	int64 Written = 0;
+
+	while (PendingCount > 0 && Consumed < Count)
+	{
+		if (PendingCount == 2)
+		{
+			Base64EncodeTriplet(Pending[0], Pending[1], Src[Consumed++], Dst);
+			Written = 4;
+			PendingCount = 0;
+			break;
+		}
+		Pending[PendingCount++] = Src[Consumed++];
+	}
+
+	const int64 BlockConsumed = Base64EncodeBlocks(ResolveKernel(Kernel), Src + Consumed, Count - Consumed, Dst + Written);
+	Consumed += BlockConsumed;
+	Written += BlockConsumed / 3 * 4;
+
+	for (; Count - Consumed >= 3; Consumed += 3, Written += 4)
+	{
+		Base64EncodeTriplet(Src[Consumed], Src[Consumed + 1], Src[Consumed + 2], Dst + Written);
+	}
+
+	while (Consumed < Count)
+	{
+		Pending[PendingCount++] = Src[Consumed++];
+	}
+	return Written;
+}
+
+int64 PSGCPCodec::FBase64Encoder::Finish(ANSICHAR* Dst)
+{
+	if (PendingCount == 0) return 0;
+
+	Base64EncodeTriplet(Pending[0], PendingCount > 1 ? Pending[1] : 0, 0, Dst);
+	Dst[3] = '=';
+	if (PendingCount == 1)
+	{
+		Dst[2] = '=';
+	}
+	PendingCount = 0;
+	return 4;
+}
+
+bool PSGCPCodec::FBase64Decoder::Update(const ANSICHAR* Src, int64 Count, uint8* Dst, int64& OutWritten)
+{
+	OutWritten = 0;
+	if (bFailed) return false;
+
+	const int8* Table = GetDecodeTables().Base64;
+
+	for (int64 Consumed = 0; Consumed < Count; Consumed++)
+	{
+		if (QuantumCount == 0 && PaddingCount == 0 && !bClosed)
+		{
+			const int64 BlockConsumed = Base64DecodeBlocks(ResolveKernel(Kernel), Src + Consumed, Count - Consumed, Dst + OutWritten);
+			Consumed += BlockConsumed;
+			OutWritten += BlockConsumed / 4 * 3;
+			if (Consumed == Count) break;
+		}
+
+		const ANSICHAR Character = Src[Consumed];
+		if (Character == '=')
+		{
+			//Padding may only complete a quantum that already has two or three characters.
+			if (bClosed || QuantumCount < 2 || QuantumCount + PaddingCount >= 4)
+			{
+				bFailed = true;
+				return false;
+			}
+			if (++PaddingCount + QuantumCount == 4)
+			{
+				Dst[OutWritten++] = (uint8)(Quantum >> (QuantumCount == 2 ? 4 : 10));
+				if (QuantumCount == 3)
+				{
+					Dst[OutWritten++] = (uint8)(Quantum >> 2);
+				}
+				Quantum = 0;
+				QuantumCount = 0;
+				bClosed = true;
+			}
+			continue;
+		}
+
+		const int8 Value = Table[(uint8)Character];
+		if (Value < 0 || PaddingCount > 0 || bClosed)
+		{
+			bFailed = true;
+			return false;
+		}
+
+		Quantum = (Quantum << 6) | (uint32)Value;
+		if (++QuantumCount == 4)
+		{
+			Dst[OutWritten++] = (uint8)(Quantum >> 16);
+			Dst[OutWritten++] = (uint8)(Quantum >> 8);
+			Dst[OutWritten++] = (uint8)Quantum;
+			Quantum = 0;
+			QuantumCount = 0;
+		}
+	}
+	return true;
+}
+
+bool PSGCPCodec::FBase64Decoder::Finish(uint8* Dst, int64& OutWritten)
+{
+	OutWritten = 0;
+	if (bFailed || QuantumCount == 1 || (PaddingCount > 0 && !bClosed)) return false;
+
+	if (QuantumCount == 2)
+	{
+		Dst[OutWritten++] = (uint8)(Quantum >> 4);
+	}
+	else if (QuantumCount == 3)
+	{
+		Dst[OutWritten++] = (uint8)(Quantum >> 10);
+		Dst[OutWritten++] = (uint8)(Quantum >> 2);
+	}
+	Quantum = 0;
+	QuantumCount = 0;
+	return true;
+}
@@ -0,0 +1,697 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "PSGCPProcessLog.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/Event.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "BLambdaRunnable.h"
+#include <string.h>
+
+#define PSGCP_PROCESS_LOG_INDEX_STRIDE 64
+#define PSGCP_PROCESS_LOG_READ_CHUNK_SIZE (64 * 1024)
+#define PSGCP_PROCESS_LOG_WRITER_WAIT_MS 100
+
+namespace
+{
+	FCriticalSection& GetRegistryLock()
+	{
+		static FCriticalSection Lock;
+		return Lock;
+	}
+
+	//Keyed by folder/name; logs stay registered after they are closed, so their index is not rebuilt on every read.
+	TMap<FString, PSGCPProcessLog::FPtr>& GetRegistry()
+	{
+		static TMap<FString, PSGCPProcessLog::FPtr> Registry;
+		return Registry;
+	}
+
+	//Splits "<Name>.<Sequence>.log".
+	bool ParseSegmentFileName(const FString& FileName, FString& OutName, int32& OutSequence)
+	{
+		if (!FileName.EndsWith(TEXT(".log"))) return false;
+
+		const FString WithoutExtension = FileName.LeftChop(4);
+
+		int32 DotIndex = INDEX_NONE;
+		if (!WithoutExtension.FindLastChar(TEXT('.'), DotIndex)) return false;
+
+		const FString SequenceString = WithoutExtension.Mid(DotIndex + 1);
+		if (SequenceString.Len() == 0 || !SequenceString.IsNumeric()) return false;
+
+		OutName = WithoutExtension.Left(DotIndex);
+		OutSequence = FCString::Atoi(*SequenceString);
+		return OutName.Len() > 0;
+	}
+
+	void FindSegments(const FString& FolderAbsolutePath, TMap<FString, TArray<int32>>& OutSegmentsByName)
+	{
+		TArray<FString> FileNames;
+		IFileManager::Get().FindFiles(FileNames, *(FolderAbsolutePath / TEXT("*.log")), true, false);
+
+		for (const FString& FileName : FileNames)
+		{
+			FString Name;
+			int32 Sequence = 0;
+			if (ParseSegmentFileName(FileName, Name, Sequence))
+			{
+				OutSegmentsByName.FindOrAdd(Name).Add(Sequence);
+			}
+		}
+		for (auto& Pair : OutSegmentsByName)
+		{
+			Pair.Value.Sort();
+		}
+	}
+
+	//Filters are usually ASCII; they are matched on the UTF-8 bytes, which never produce an ASCII byte inside a multibyte sequence.
+	bool ContainsAsciiIgnoreCase(const ANSICHAR* Line, int32 Length, const TArray<ANSICHAR>& LowerNeedle)
+	{
+		const int32 NeedleLength = LowerNeedle.Num();
+		for (int32 i = 0; i + NeedleLength <= Length; i++)
+		{
+			int32 j = 0;
+			while (j < NeedleLength && FCharAnsi::ToLower(Line[i + j]) == LowerNeedle[j]) j++;
+			if (j == NeedleLength) return true;
+		}
+		return false;
+	}
+
+	FString LineToString(const ANSICHAR* Line, int32 Length)
+	{
+		FUTF8ToTCHAR Converted(Line, Length);
+		return FString(Converted.Length(), Converted.Get());
+	}
+}
+
+PSGCPProcessLog::PSGCPProcessLog(const FString& InFolderAbsolutePath, const FString& InName, int64 InMaxSegmentSize, int32 InMaxSegments)
+	: FolderAbsolutePath(InFolderAbsolutePath)
+	, Name(InName)
+	, MaxSegmentSize(InMaxSegmentSize)
+	, MaxSegments(FMath::Max(InMaxSegments, 1))
+	, bCloseRequested(false)
+	, bWriterRunning(false)
+{
+	DataEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	SpaceEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	WriterStoppedEvent = FPlatformProcess::GetSynchEventFromPool(true);
+}
+
+PSGCPProcessLog::~PSGCPProcessLog()
+{
+	FPlatformProcess::ReturnSynchEventToPool(DataEvent);
+	FPlatformProcess::ReturnSynchEventToPool(SpaceEvent);
+	FPlatformProcess::ReturnSynchEventToPool(WriterStoppedEvent);
+}
+
+PSGCPProcessLog::FPtr PSGCPProcessLog::Create(const FString& FolderAbsolutePath, const FString& Name, FString& ErrorMessage, int64 MaxSegmentSize, int32 MaxSegments, int32 RingSize)
+{
+	const FString ValidName = FPaths::MakeValidFileName(Name);
+
+	if (!IFileManager::Get().MakeDirectory(*FolderAbsolutePath, true))
+	{
+		ErrorMessage = FString::Printf(TEXT("Failed to create the log folder at %s"), *FolderAbsolutePath);
+		return nullptr;
+	}
+
+	TMap<FString, TArray<int32>> ExistingSegments;
+	FindSegments(FolderAbsolutePath, ExistingSegments);
+	if (ExistingSegments.Contains(ValidName))
+	{
+		ErrorMessage = FString::Printf(TEXT("A log named %s already exists."), *ValidName);
+		return nullptr;
+	}
+
+	FPtr Log(new PSGCPProcessLog(FolderAbsolutePath, ValidName, FMath::Max<int64>(MaxSegmentSize, 1), MaxSegments));
+	Log->Ring.SetNumUninitialized(FMath::Max(RingSize, 1));
+
+	if (!Log->OpenSegment(0, 0, ErrorMessage))
+	{
+		return nullptr;
+	}
+
+	Log->bWriterRunning = true;
+	FBLambdaRunnable::RunLambdaOnDedicatedBackgroundThread([Log]()
+		{
+			Log->RunWriter();
+		});
+
+	FScopeLock Lock(&GetRegistryLock());
+	GetRegistry().Add(FolderAbsolutePath / ValidName, Log);
+	return Log;
+}
+
+PSGCPProcessLog::FPtr PSGCPProcessLog::FindOrOpen(const FString& FolderAbsolutePath, const FString& Name, FString& ErrorMessage)
+{
+	const FString Key = FolderAbsolutePath / Name;
+	{
+		FScopeLock Lock(&GetRegistryLock());
+		if (FPtr* Existing = GetRegistry().Find(Key))
+		{
+			return *Existing;
+		}
+	}
+
+	TMap<FString, TArray<int32>> SegmentsByName;
+	FindSegments(FolderAbsolutePath, SegmentsByName);
+
+	const TArray<int32>* Sequences = SegmentsByName.Find(Name);
+	if (!Sequences)
+	{
+		ErrorMessage = FString::Printf(TEXT("No log named %s in %s"), *Name, *FolderAbsolutePath);
+		return nullptr;
+	}
+
+	FPtr Log(new PSGCPProcessLog(FolderAbsolutePath, Name, PSGCP_PROCESS_LOG_DEFAULT_SEGMENT_SIZE, Sequences->Num()));
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(PSGCP_PROCESS_LOG_READ_CHUNK_SIZE);
+
+	//Dropped segments are gone with their line counts, so numbering of a reopened log starts at its oldest remaining segment.
+	int64 NextFirstLine = 0;
+	for (int32 Sequence : *Sequences)
+	{
+		TUniquePtr<IFileHandle> Handle(PlatformFile.OpenRead(*Log->GetSegmentPath(Sequence), true));
+		if (!Handle.IsValid()) continue;
+
+		FSegment Segment;
+		Segment.Sequence = Sequence;
+		Segment.FirstLine = NextFirstLine;
+		Segment.Checkpoints.Add(0);
+
+		const int64 Size = Handle->Size();
+		int64 Offset = 0;
+		uint8 LastByte = '\n';
+		while (Offset < Size)
+		{
+			const int64 ToRead = FMath::Min<int64>(Buffer.Num(), Size - Offset);
+			if (!Handle->Read(Buffer.GetData(), ToRead))
+			{
+				ErrorMessage = FString::Printf(TEXT("Failed to read %s"), *Log->GetSegmentPath(Sequence));
+				return nullptr;
+			}
+
+			const uint8* Cursor = Buffer.GetData();
+			const uint8* End = Cursor + ToRead;
+			while (const uint8* NewLine = (const uint8*)memchr(Cursor, '\n', End - Cursor))
+			{
+				Segment.LineCount++;
+				if (Segment.LineCount % PSGCP_PROCESS_LOG_INDEX_STRIDE == 0)
+				{
+					Segment.Checkpoints.Add(Offset + (NewLine - Buffer.GetData()) + 1);
+				}
+				Cursor = NewLine + 1;
+			}
+			Offset += ToRead;
+			LastByte = End[-1];
+		}
+
+		//A process that was killed leaves its last line unterminated.
+		if (LastByte != '\n')
+		{
+			Segment.LineCount++;
+		}
+		Segment.IndexedSize = Size;
+
+		NextFirstLine = Segment.FirstLine + Segment.LineCount;
+		Log->Segments.Add(MoveTemp(Segment));
+	}
+
+	FScopeLock Lock(&GetRegistryLock());
+	if (FPtr* Existing = GetRegistry().Find(Key))
+	{
+		return *Existing;
+	}
+	GetRegistry().Add(Key, Log);
+	return Log;
+}
+
+void PSGCPProcessLog::ListLogs(const FString& FolderAbsolutePath, TArray<FString>& OutNames)
+{
+	TMap<FString, TArray<int32>> SegmentsByName;
+	FindSegments(FolderAbsolutePath, SegmentsByName);
+
+	SegmentsByName.GetKeys(OutNames);
+	OutNames.Sort();
+}
+
+void PSGCPProcessLog::PruneLogs(const FString& FolderAbsolutePath, int32 KeepCount)
+{
+	TMap<FString, TArray<int32>> SegmentsByName;
+	FindSegments(FolderAbsolutePath, SegmentsByName);
+
+	TArray<FString> Names;
+	SegmentsByName.GetKeys(Names);
+	Names.Sort();
+
+	for (int32 i = 0; i < Names.Num() - KeepCount; i++)
+	{
+		{
+			FScopeLock Lock(&GetRegistryLock());
+
+			const FString Key = FolderAbsolutePath / Names[i];
+			if (FPtr* Existing = GetRegistry().Find(Key))
+			{
+				if ((*Existing)->bWriterRunning) continue;
+				GetRegistry().Remove(Key);
+			}
+		}
+
+		for (int32 Sequence : SegmentsByName[Names[i]])
+		{
+			IFileManager::Get().Delete(*FString::Printf(TEXT("%s/%s.%d.log"), *FolderAbsolutePath, *Names[i], Sequence), false, false, true);
+		}
+	}
+}
+
+FString PSGCPProcessLog::GetSegmentPath(int32 Sequence) const
+{
+	return FString::Printf(TEXT("%s/%s.%d.log"), *FolderAbsolutePath, *Name, Sequence);
+}
+
+bool PSGCPProcessLog::OpenSegment(int32 Sequence, int64 FirstLine, FString& ErrorMessage)
+{
+	IFileHandle* Handle = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*GetSegmentPath(Sequence), false, true);
+	if (!Handle)
+	{
+		ErrorMessage = FString::Printf(TEXT("Failed to open %s for writing."), *GetSegmentPath(Sequence));
+		return false;
+	}
+	SegmentHandle.Reset(Handle);
+	SegmentWrittenSize = 0;
+
+	FSegment Segment;
+	Segment.Sequence = Sequence;
+	Segment.FirstLine = FirstLine;
+	Segment.Checkpoints.Add(0);
+	{
+		FScopeLock Lock(&IndexLock);
+		Segments.Add(MoveTemp(Segment));
+		while (Segments.Num() > MaxSegments)
+		{
+			PendingDeletes.Add(GetSegmentPath(Segments[0].Sequence));
+			Segments.RemoveAt(0);
+		}
+	}
+	DeleteDroppedSegments();
+	return true;
+}
+
+void PSGCPProcessLog::DeleteDroppedSegments()
+{
+	//A reader may still have a dropped segment open; it is retried on the next rotation.
+	for (int32 i = PendingDeletes.Num() - 1; i >= 0; i--)
+	{
+		if (IFileManager::Get().Delete(*PendingDeletes[i], false, false, true) || !IFileManager::Get().FileExists(*PendingDeletes[i]))
+		{
+			PendingDeletes.RemoveAt(i);
+		}
+	}
+}
+
+void PSGCPProcessLog::Append(const uint8* Data, int32 Count)
+{
+	while (Count > 0 && bWriterRunning && !bCloseRequested)
+	{
+		int32 Copied = 0;
+		{
+			FScopeLock Lock(&RingLock);
+
+			//The ring is freed once the writer stops.
+			const uint64 Capacity = (uint64)Ring.Num();
+			if (Capacity == 0) return;
+
+			Copied = (int32)FMath::Min<uint64>(Capacity - (RingHead - RingTail), (uint64)Count);
+
+			const int32 Start = (int32)(RingHead % Capacity);
+			const int32 FirstPart = FMath::Min(Copied, (int32)Capacity - Start);
+			FMemory::Memcpy(Ring.GetData() + Start, Data, FirstPart);
+			FMemory::Memcpy(Ring.GetData(), Data + FirstPart, Copied - FirstPart);
+			RingHead += Copied;
+		}
+
+		if (Copied > 0)
+		{
+			DataEvent->Trigger();
+			Data += Copied;
+			Count -= Copied;
+		}
+		else
+		{
+			SpaceEvent->Wait(PSGCP_PROCESS_LOG_WRITER_WAIT_MS);
+		}
+	}
+}
+
+void PSGCPProcessLog::Close()
+{
+	if (!bWriterRunning) return;
+
+	bCloseRequested = true;
+	DataEvent->Trigger();
+	WriterStoppedEvent->Wait();
+}
+
+void PSGCPProcessLog::RunWriter()
+{
+	TArray<uint8> Batch;
+	Batch.SetNumUninitialized(Ring.Num());
+
+	while (true)
+	{
+		const bool bClosing = bCloseRequested;
+
+		int32 Count = 0;
+		{
+			FScopeLock Lock(&RingLock);
+
+			const uint64 Capacity = (uint64)Ring.Num();
+			Count = (int32)(RingHead - RingTail);
+
+			const int32 Start = (int32)(RingTail % Capacity);
+			const int32 FirstPart = FMath::Min(Count, (int32)Capacity - Start);
+			FMemory::Memcpy(Batch.GetData(), Ring.GetData() + Start, FirstPart);
+			FMemory::Memcpy(Batch.GetData() + FirstPart, Ring.GetData(), Count - FirstPart);
+			RingTail += Count;
+		}
+
+		if (Count > 0)
+		{
+			SpaceEvent->Trigger();
+			WriteBatch(Batch.GetData(), Count);
+		}
+		else if (bClosing)
+		{
+			break;
+		}
+		else
+		{
+			DataEvent->Wait(PSGCP_PROCESS_LOG_WRITER_WAIT_MS);
+		}
+	}
+
+	if (SegmentHandle.IsValid() && SegmentWrittenSize > Segments.Last().IndexedSize)
+	{
+		const uint8 NewLine = '\n';
+		WriteBatch(&NewLine, 1);
+	}
+	if (SegmentHandle.IsValid())
+	{
+		SegmentHandle->Flush();
+		SegmentHandle.Reset();
+	}
+	DeleteDroppedSegments();
+
+	//Closed logs stay registered for readers; only the index is needed for that.
+	{
+		FScopeLock Lock(&RingLock);
+		Ring.Empty();
+	}
+
+	bWriterRunning = false;
+	SpaceEvent->Trigger();
+	WriterStoppedEvent->Trigger();
+}
+
+void PSGCPProcessLog::WriteBatch(const uint8* Data, int64 Count)
+{
+	while (Count > 0 && SegmentHandle.IsValid())
+	{
+		//Only the writer thread changes Segments, so it reads the last one without the lock.
+		const FSegment& Current = Segments.Last();
+
+		int64 Take = Count;
+		int64 NewLines = 0;
+		int64 LastLineEnd = -1;
+		bool bRotate = false;
+		bool bBreakLine = false;
+		TArray<int64, TInlineAllocator<64>> NewCheckpoints;
+
+		//Bytes of the unterminated line already in the segment.
+		int64 LineLength = SegmentWrittenSize - Current.IndexedSize;
+
+		const uint8* Cursor = Data;
+		const uint8* End = Data + Count;
+		while (Cursor < End)
+		{
+			//A line may take PSGCP_PROCESS_LOG_MAX_LINE_LENGTH bytes before its '\n'.
+			const int64 LineRoom = FMath::Max<int64>(PSGCP_PROCESS_LOG_MAX_LINE_LENGTH - LineLength, 0);
+			const int64 ScanLength = FMath::Min<int64>(End - Cursor, LineRoom + 1);
+
+			const uint8* NewLine = (const uint8*)memchr(Cursor, '\n', ScanLength);
+			if (!NewLine)
+			{
+				//Output without line breaks, like '\r' progress bars, is broken into capped lines so segments and reads stay bounded.
+				if (ScanLength == LineRoom + 1)
+				{
+					Take = (Cursor + LineRoom) - Data;
+					bBreakLine = true;
+				}
+				break;
+			}
+
+			NewLines++;
+			LineLength = 0;
+			LastLineEnd = SegmentWrittenSize + (NewLine - Data) + 1;
+			if ((Current.LineCount + NewLines) % PSGCP_PROCESS_LOG_INDEX_STRIDE == 0)
+			{
+				NewCheckpoints.Add(LastLineEnd);
+			}
+			Cursor = NewLine + 1;
+
+			//Segments are only rotated at line boundaries, so a line never spans two files.
+			if (LastLineEnd >= MaxSegmentSize)
+			{
+				Take = Cursor - Data;
+				bRotate = true;
+				break;
+			}
+		}
+
+		if (Take > 0 && !SegmentHandle->Write(Data, Take))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("PSGCPProcessLog: Failed to write to %s"), *GetSegmentPath(Current.Sequence));
+
+			//Whatever reached the file becomes part of the next line; offsets stay valid as long as they follow the file.
+			SegmentWrittenSize = SegmentHandle->Tell();
+			return;
+		}
+		SegmentWrittenSize += Take;
+
+		const int32 Sequence = Current.Sequence;
+		int64 NextFirstLine = 0;
+		{
+			FScopeLock Lock(&IndexLock);
+
+			FSegment& Segment = Segments.Last();
+			Segment.LineCount += NewLines;
+			if (LastLineEnd >= 0)
+			{
+				Segment.IndexedSize = LastLineEnd;
+			}
+			Segment.Checkpoints.Append(NewCheckpoints);
+			NextFirstLine = Segment.FirstLine + Segment.LineCount;
+		}
+
+		Data += Take;
+		Count -= Take;
+
+		if (bBreakLine)
+		{
+			const uint8 NewLine = '\n';
+			WriteBatch(&NewLine, 1);
+		}
+		else if (bRotate)
+		{
+			FString ErrorMessage;
+			SegmentHandle->Flush();
+			if (!OpenSegment(Sequence + 1, NextFirstLine, ErrorMessage))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("PSGCPProcessLog: %s Keeping %s open."), *ErrorMessage, *GetSegmentPath(Sequence));
+			}
+		}
+	}
+}
+
+void PSGCPProcessLog::GetLineRange(int64& OutFirstLine, int64& OutLineCount) const
+{
+	FScopeLock Lock(&IndexLock);
+
+	OutFirstLine = Segments.Num() > 0 ? Segments[0].FirstLine : 0;
+	OutLineCount = Segments.Num() > 0 ? Segments.Last().FirstLine + Segments.Last().LineCount - OutFirstLine : 0;
+}
+
+bool PSGCPProcessLog::VisitLines(int64 StartLine, TFunctionRef<bool(int64 LineNumber, const ANSICHAR* Line, int32 Length)> Visitor, FString& ErrorMessage) const
+{
+	struct FRange
+	{
+		int32 Sequence;
+		int64 FirstLine;
+		int64 EndLine;
+		int64 StartOffset;
+		int64 EndOffset;
+	};
+
+	TArray<FRange> Ranges;
+	{
+		FScopeLock Lock(&IndexLock);
+
+		for (const FSegment& Segment : Segments)
+		{
+			const int64 SegmentEndLine = Segment.FirstLine + Segment.LineCount;
+			if (SegmentEndLine <= StartLine) continue;
+
+			const int64 Checkpoint = FMath::Max<int64>(StartLine - Segment.FirstLine, 0) / PSGCP_PROCESS_LOG_INDEX_STRIDE;
+
+			FRange& Range = Ranges.AddDefaulted_GetRef();
+			Range.Sequence = Segment.Sequence;
+			Range.FirstLine = Segment.FirstLine + Checkpoint * PSGCP_PROCESS_LOG_INDEX_STRIDE;
+			Range.EndLine = SegmentEndLine;
+			Range.StartOffset = Segment.Checkpoints[Checkpoint];
+			Range.EndOffset = Segment.IndexedSize;
+		}
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(PSGCP_PROCESS_LOG_READ_CHUNK_SIZE);
+	TArray<ANSICHAR> Carry;
+
+	for (const FRange& Range : Ranges)
+	{
+		TUniquePtr<IFileHandle> Handle(PlatformFile.OpenRead(*GetSegmentPath(Range.Sequence), true));
+		if (!Handle.IsValid() || !Handle->Seek(Range.StartOffset))
+		{
+			//Dropped by rotation after the snapshot.
+			continue;
+		}
+
+		int64 Line = Range.FirstLine;
+		int64 Offset = Range.StartOffset;
+		Carry.Reset();
+
+		//Lines written before lines were capped are truncated, so one of them is never loaded whole.
+		auto AppendCarry = [&Carry](const uint8* Bytes, int64 Length)
+		{
+			Carry.Append((const ANSICHAR*)Bytes, FMath::Min<int64>(Length, PSGCP_PROCESS_LOG_MAX_LINE_LENGTH - Carry.Num()));
+		};
+
+		auto EmitLine = [&](const ANSICHAR* LineData, int32 Length)
+		{
+			if (Length > 0 && LineData[Length - 1] == '\r') Length--;
+			const bool bContinue = Line < StartLine || Visitor(Line, LineData, Length);
+			Line++;
+			Carry.Reset();
+			return bContinue;
+		};
+
+		while (Offset < Range.EndOffset && Line < Range.EndLine)
+		{
+			const int64 ToRead = FMath::Min<int64>(Buffer.Num(), Range.EndOffset - Offset);
+			if (!Handle->Read(Buffer.GetData(), ToRead))
+			{
+				ErrorMessage = FString::Printf(TEXT("Failed to read %s"), *GetSegmentPath(Range.Sequence));
+				return false;
+			}
+			Offset += ToRead;
+
+			const uint8* Cursor = Buffer.GetData();
+			const uint8* End = Cursor + ToRead;
+			while (Cursor < End && Line < Range.EndLine)
+			{
+				const uint8* NewLine = (const uint8*)memchr(Cursor, '\n', End - Cursor);
+				if (!NewLine)
+				{
+					AppendCarry(Cursor, End - Cursor);
+					break;
+				}
+
+				bool bContinue;
+				if (Carry.Num() > 0)
+				{
+					AppendCarry(Cursor, NewLine - Cursor);
+					bContinue = EmitLine(Carry.GetData(), Carry.Num());
+				}
+				else
+				{
+					bContinue = EmitLine((const ANSICHAR*)Cursor, NewLine - Cursor);
+				}
+				if (!bContinue) return true;
+
+				Cursor = NewLine + 1;
+			}
+		}
+
+		//Unterminated last line of a segment that was reopened from disk.
+		if (Carry.Num() > 0 && Line < Range.EndLine && !EmitLine(Carry.GetData(), Carry.Num()))
+		{
+			return true;
+		}
+	}
+	return true;
+}
+
+bool PSGCPProcessLog::ReadLines(int64 StartLine, int32 MaxLines, int64& OutFirstLine, TArray<FString>& OutLines, FString& ErrorMessage) const
+{
+	int64 FirstLine = 0;
+	int64 LineCount = 0;
+	GetLineRange(FirstLine, LineCount);
+
+	OutFirstLine = FMath::Max(StartLine, FirstLine);
+	OutLines.Reset();
+	if (MaxLines <= 0) return true;
+
+	return VisitLines(OutFirstLine, [&](int64 LineNumber, const ANSICHAR* Line, int32 Length)
+		{
+			OutLines.Add(LineToString(Line, Length));
+			return OutLines.Num() < MaxLines;
+		}, ErrorMessage);
+}
+
+bool PSGCPProcessLog::FilterLines(const FString& Filter, int64 StartLine, int32 MaxResults, TArray<int64>& OutLineNumbers, TArray<FString>& OutLines, int64& OutNextLine, FString& ErrorMessage) const
+{
+	int64 FirstLine = 0;
+	int64 LineCount = 0;
+	GetLineRange(FirstLine, LineCount);
+
+	OutLineNumbers.Reset();
+	OutLines.Reset();
+	OutNextLine = FMath::Max(StartLine, FirstLine);
+	if (MaxResults <= 0) return true;
+
+	bool bAsciiFilter = true;
+	for (TCHAR Character : Filter)
+	{
+		bAsciiFilter &= Character < 128;
+	}
+
+	TArray<ANSICHAR> LowerNeedle;
+	if (bAsciiFilter)
+	{
+		for (TCHAR Character : Filter)
+		{
+			LowerNeedle.Add(FCharAnsi::ToLower((ANSICHAR)Character));
+		}
+	}
+
+	return VisitLines(OutNextLine, [&](int64 LineNumber, const ANSICHAR* Line, int32 Length)
+		{
+			OutNextLine = LineNumber + 1;
+
+			const bool bMatches = bAsciiFilter
+				? ContainsAsciiIgnoreCase(Line, Length, LowerNeedle)
+				: LineToString(Line, Length).Contains(Filter, ESearchCase::IgnoreCase);
+
+			if (bMatches)
+			{
+				OutLineNumbers.Add(LineNumber);
+				OutLines.Add(LineToString(Line, Length));
+			}
+			return OutLines.Num() < MaxResults;
+		}, ErrorMessage);
+}
@@ -0,0 +1,44 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "PSGCPProcessorReleaseCommandlet.h"
+#include "PSGCPProcessorUpdater.h"
+#include "Misc/Paths.h"
+
+UPSGCPProcessorReleaseCommandlet::UPSGCPProcessorReleaseCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UPSGCPProcessorReleaseCommandlet::Main(const FString& Params)
+{
+	FString ReleaseFolder;
+	FString OutputFolder;
+	FString PreviousFolders;
+
+	if (!FParse::Value(*Params, TEXT("Release="), ReleaseFolder) || !FParse::Value(*Params, TEXT("Output="), OutputFolder))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UPSGCPProcessorReleaseCommandlet: Usage: -run=PSGCPProcessorRelease -Release=<folder> -Output=<folder> [-Previous=<folder>+<folder>]"));
+		return 1;
+	}
+	FParse::Value(*Params, TEXT("Previous="), PreviousFolders);
+
+	TArray<FString> PreviousFolderAbsolutePaths;
+	PreviousFolders.ParseIntoArray(PreviousFolderAbsolutePaths, TEXT("+"));
+	for (FString& PreviousFolder : PreviousFolderAbsolutePaths)
+	{
+		PreviousFolder = FPaths::ConvertRelativePathToFull(PreviousFolder);
+	}
+
+	FString ErrorMessage;
+	if (!PSGCPProcessorUpdater::BuildRelease(FPaths::ConvertRelativePathToFull(ReleaseFolder), PreviousFolderAbsolutePaths, FPaths::ConvertRelativePathToFull(OutputFolder), ErrorMessage))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UPSGCPProcessorReleaseCommandlet: %s"), *ErrorMessage);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UPSGCPProcessorReleaseCommandlet: Release is written to %s"), *FPaths::ConvertRelativePathToFull(OutputFolder));
+	return 0;
+}
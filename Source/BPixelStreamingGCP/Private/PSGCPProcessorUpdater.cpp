@@ -0,0 +1,831 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "PSGCPProcessorUpdater.h"
+#include "PSGCPCodec.h"
+#include "PSGCPResumableZip.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "JsonUtilities.h"
+#include "BLambdaRunnable.h"
+#include "Runtime/Online/HTTP/Public/Http.h"
+
+#define PSGCP_PATCH_MAGIC "PSGCPDF1"
+#define PSGCP_PATCH_OP_END 0
+#define PSGCP_PATCH_OP_COPY 1
+#define PSGCP_PATCH_OP_INSERT 2
+
+//Source is indexed in blocks of this size; shorter matches are inserted.
+#define PSGCP_PATCH_BLOCK_SIZE 32
+#define PSGCP_PATCH_HASH_BASE 0x01000193u
+
+//Above this share of the full zip, downloading the full release is preferred.
+#define PSGCP_PATCH_MAX_DOWNLOAD_RATIO 0.7
+
+namespace
+{
+	enum class EPSGCPUpdateAction : uint8
+	{
+		Keep,
+		Patch,
+		Download
+	};
+
+	struct FPSGCPUpdatePatch
+	{
+		FString FromSha1;
+		FString Url;
+		int64 Size = 0;
+	};
+
+	struct FPSGCPUpdateFile
+	{
+		FString Path;
+		FString Sha1;
+		FString Url;
+		int64 Size = 0;
+		TArray<FPSGCPUpdatePatch> Patches;
+
+		EPSGCPUpdateAction Action = EPSGCPUpdateAction::Download;
+		FString DownloadUrl;
+		TArray<uint8> Downloaded;
+		bool bDownloadFinished = false;
+	};
+
+	struct FPSGCPUpdateJob
+	{
+		FString ReleasesBaseUrl;
+		FString InstalledFolder;
+		FString StagingFolder;
+		int64 ZipSize = 0;
+		TArray<FPSGCPUpdateFile> Files;
+
+		bool bManifestReceived = false;
+		int32 PendingDownloads = 0;
+		FString DownloadErrorMessage;
+
+		TFunction<void(bool, const FString&)> OnComplete;
+	};
+
+	typedef TSharedRef<FPSGCPUpdateJob, ESPMode::ThreadSafe> FPSGCPUpdateJobRef;
+
+	FString Sha1ToHex(const uint8* Hash)
+	{
+		ANSICHAR HashHex[FSHA1::DigestSize * 2 + 1];
+		PSGCPCodec::HexEncode(Hash, FSHA1::DigestSize, HashHex);
+		HashHex[FSHA1::DigestSize * 2] = '\0';
+		return FString(HashHex);
+	}
+
+	FString HashBuffer(const TArray<uint8>& Buffer)
+	{
+		uint8 Hash[FSHA1::DigestSize];
+		FSHA1::HashBuffer(Buffer.GetData(), Buffer.Num(), Hash);
+		return Sha1ToHex(Hash);
+	}
+
+	bool HashFile(const FString& Path, FString& OutSha1)
+	{
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Path));
+		if (!Handle.IsValid()) return false;
+
+		FSHA1 Hasher;
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized(1024 * 1024);
+		for (int64 Remaining = Handle->Size(); Remaining > 0;)
+		{
+			const int64 ReadSize = FMath::Min<int64>(Remaining, Buffer.Num());
+			if (!Handle->Read(Buffer.GetData(), ReadSize)) return false;
+			Hasher.Update(Buffer.GetData(), ReadSize);
+			Remaining -= ReadSize;
+		}
+		Hasher.Final();
+
+		uint8 Hash[FSHA1::DigestSize];
+		Hasher.GetHash(Hash);
+		OutSha1 = Sha1ToHex(Hash);
+		return true;
+	}
+
+	bool IsSafeRelativePath(const FString& Path)
+	{
+		return !Path.IsEmpty() && FPaths::IsRelative(Path) && !Path.Contains(TEXT("..")) && !Path.Contains(TEXT(":"));
+	}
+
+	bool ParseManifest(const FString& JsonString, FPSGCPUpdateJob& Job, FString& ErrorMessage)
+	{
+		TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+
+		const TArray<TSharedPtr<FJsonValue>>* FileValues;
+		if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid()
+			|| !JsonObject->TryGetNumberField("zipSize", Job.ZipSize)
+			|| !JsonObject->TryGetArrayField("files", FileValues)
+			|| FileValues->Num() == 0)
+		{
+			ErrorMessage = "Manifest is invalid.";
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& FileValue : *FileValues)
+		{
+			const TSharedPtr<FJsonObject>* FileObject;
+			FPSGCPUpdateFile File;
+
+			if (!FileValue->TryGetObject(FileObject)
+				|| !(*FileObject)->TryGetStringField("path", File.Path)
+				|| !(*FileObject)->TryGetStringField("sha1", File.Sha1)
+				|| !(*FileObject)->TryGetStringField("url", File.Url)
+				|| !(*FileObject)->TryGetNumberField("size", File.Size)
+				|| !IsSafeRelativePath(File.Path))
+			{
+				ErrorMessage = "Manifest has an invalid file entry.";
+				return false;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* PatchValues;
+			if ((*FileObject)->TryGetArrayField("patches", PatchValues))
+			{
+				for (const TSharedPtr<FJsonValue>& PatchValue : *PatchValues)
+				{
+					const TSharedPtr<FJsonObject>* PatchObject;
+					FPSGCPUpdatePatch Patch;
+
+					if (PatchValue->TryGetObject(PatchObject)
+						&& (*PatchObject)->TryGetStringField("fromSha1", Patch.FromSha1)
+						&& (*PatchObject)->TryGetStringField("url", Patch.Url)
+						&& (*PatchObject)->TryGetNumberField("size", Patch.Size))
+					{
+						File.Patches.Add(Patch);
+					}
+				}
+			}
+			Job.Files.Add(File);
+		}
+		return true;
+	}
+
+	//Runs on a background thread; decides per file whether it is kept, patched or downloaded.
+	bool PlanUpdate(FPSGCPUpdateJob& Job, FString& ErrorMessage)
+	{
+		int64 DownloadSize = 0;
+
+		for (FPSGCPUpdateFile& File : Job.Files)
+		{
+			FString InstalledSha1;
+			const FString InstalledPath = Job.InstalledFolder / File.Path;
+
+			if (!FPaths::FileExists(InstalledPath) || !HashFile(InstalledPath, InstalledSha1))
+			{
+				File.Action = EPSGCPUpdateAction::Download;
+			}
+			else if (InstalledSha1.Equals(File.Sha1, ESearchCase::IgnoreCase))
+			{
+				File.Action = EPSGCPUpdateAction::Keep;
+				continue;
+			}
+			else if (const FPSGCPUpdatePatch* Patch = File.Patches.FindByPredicate([&InstalledSha1](const FPSGCPUpdatePatch& Candidate) { return Candidate.FromSha1.Equals(InstalledSha1, ESearchCase::IgnoreCase); }))
+			{
+				File.Action = EPSGCPUpdateAction::Patch;
+				File.DownloadUrl = Job.ReleasesBaseUrl + Patch->Url;
+				DownloadSize += Patch->Size;
+				continue;
+			}
+
+			File.Action = EPSGCPUpdateAction::Download;
+			File.DownloadUrl = Job.ReleasesBaseUrl + File.Url;
+			DownloadSize += File.Size;
+		}
+
+		if (Job.ZipSize > 0 && DownloadSize > Job.ZipSize * PSGCP_PATCH_MAX_DOWNLOAD_RATIO)
+		{
+			ErrorMessage = FString::Printf(TEXT("Patch would download %lld of %lld bytes."), DownloadSize, Job.ZipSize);
+			return false;
+		}
+		return true;
+	}
+
+	//True if the installed folder holds files the manifest does not list; they are dropped by staging a new folder.
+	bool HasUnlistedInstalledFiles(const FPSGCPUpdateJob& Job)
+	{
+		TArray<FString> InstalledFiles;
+		IFileManager::Get().FindFilesRecursive(InstalledFiles, *Job.InstalledFolder, TEXT("*"), true, false);
+
+		for (FString& InstalledFile : InstalledFiles)
+		{
+			FPaths::MakePathRelativeTo(InstalledFile, *(Job.InstalledFolder / TEXT("")));
+			if (!Job.Files.ContainsByPredicate([&InstalledFile](const FPSGCPUpdateFile& File) { return FPaths::IsSamePath(File.Path, InstalledFile); }))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//Runs on a background thread; builds the new release in the staging folder, then swaps it with the installed one.
+	bool ApplyUpdate(FPSGCPUpdateJob& Job, FString& ErrorMessage)
+	{
+		if (!Job.Files.ContainsByPredicate([](const FPSGCPUpdateFile& File) { return File.Action != EPSGCPUpdateAction::Keep; })
+			&& !HasUnlistedInstalledFiles(Job))
+		{
+			return true;
+		}
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		PlatformFile.DeleteDirectoryRecursively(*Job.StagingFolder);
+
+		for (FPSGCPUpdateFile& File : Job.Files)
+		{
+			const FString InstalledPath = Job.InstalledFolder / File.Path;
+			const FString StagedPath = Job.StagingFolder / File.Path;
+
+			PlatformFile.CreateDirectoryTree(*FPaths::GetPath(StagedPath));
+
+			if (File.Action == EPSGCPUpdateAction::Keep)
+			{
+				if (!PlatformFile.CopyFile(*StagedPath, *InstalledPath))
+				{
+					ErrorMessage = FString::Printf(TEXT("Failed to copy %s."), *File.Path);
+					return false;
+				}
+				continue;
+			}
+
+			TArray<uint8> Content;
+			if (File.Action == EPSGCPUpdateAction::Patch)
+			{
+				TArray<uint8> Installed;
+				if (!FFileHelper::LoadFileToArray(Installed, *InstalledPath)
+					|| !PSGCPProcessorUpdater::ApplyBinaryPatch(Installed, File.Downloaded, File.Size, Content, ErrorMessage))
+				{
+					ErrorMessage = FString::Printf(TEXT("Failed to patch %s. %s"), *File.Path, *ErrorMessage);
+					return false;
+				}
+			}
+			else
+			{
+				Content = MoveTemp(File.Downloaded);
+			}
+
+			if (!HashBuffer(Content).Equals(File.Sha1, ESearchCase::IgnoreCase))
+			{
+				ErrorMessage = FString::Printf(TEXT("Hash of %s does not match the manifest."), *File.Path);
+				return false;
+			}
+
+			if (!FFileHelper::SaveArrayToFile(Content, *StagedPath))
+			{
+				ErrorMessage = FString::Printf(TEXT("Failed to save %s."), *File.Path);
+				return false;
+			}
+		}
+
+		const FString PreviousFolder = Job.InstalledFolder + TEXT("_previous");
+		PlatformFile.DeleteDirectoryRecursively(*PreviousFolder);
+
+		if (!PlatformFile.MoveFile(*PreviousFolder, *Job.InstalledFolder))
+		{
+			ErrorMessage = "Failed to move the installed version aside; it may be running.";
+			return false;
+		}
+		if (!PlatformFile.MoveFile(*Job.InstalledFolder, *Job.StagingFolder))
+		{
+			PlatformFile.MoveFile(*Job.InstalledFolder, *PreviousFolder);
+			ErrorMessage = "Failed to move the staged version in place.";
+			return false;
+		}
+		PlatformFile.DeleteDirectoryRecursively(*PreviousFolder);
+		return true;
+	}
+
+	void CompleteOnGameThread(const FPSGCPUpdateJobRef& Job, bool bSucceed, const FString& ErrorMessage)
+	{
+		FBLambdaRunnable::RunLambdaOnGameThread([Job, bSucceed, ErrorMessage]()
+			{
+				if (!bSucceed)
+				{
+					FPlatformFileManager::Get().GetPlatformFile().DeleteDirectoryRecursively(*Job->StagingFolder);
+				}
+				Job->OnComplete(bSucceed, ErrorMessage);
+			});
+	}
+
+	void ApplyOnBackgroundThread(const FPSGCPUpdateJobRef& Job)
+	{
+		FBLambdaRunnable::RunLambdaOnDedicatedBackgroundThread([Job]()
+			{
+				FString ErrorMessage;
+				const bool bSucceed = ApplyUpdate(Job.Get(), ErrorMessage);
+				CompleteOnGameThread(Job, bSucceed, ErrorMessage);
+			});
+	}
+
+	//Some HTTP backends also call the completion delegate of a request that failed to start; each download finishes once.
+	void OnDownloadFinished(const FPSGCPUpdateJobRef& Job, int32 FileIndex, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+	{
+		FPSGCPUpdateFile& File = Job->Files[FileIndex];
+		if (File.bDownloadFinished) return;
+		File.bDownloadFinished = true;
+
+		if (!bConnectedSuccessfully || !Response.IsValid())
+		{
+			Job->DownloadErrorMessage = FString::Printf(TEXT("Failed to download %s."), *File.DownloadUrl);
+		}
+		else if (Response->GetResponseCode() >= 400)
+		{
+			Job->DownloadErrorMessage = FString::Printf(TEXT("Request for %s returned %d"), *File.DownloadUrl, Response->GetResponseCode());
+		}
+		else
+		{
+			File.Downloaded = Response->GetContent();
+		}
+
+		if (--Job->PendingDownloads > 0) return;
+
+		if (!Job->DownloadErrorMessage.IsEmpty())
+		{
+			Job->OnComplete(false, Job->DownloadErrorMessage);
+			return;
+		}
+		ApplyOnBackgroundThread(Job);
+	}
+
+	void StartDownloads(const FPSGCPUpdateJobRef& Job)
+	{
+		for (int32 i = 0; i < Job->Files.Num(); i++)
+		{
+			if (Job->Files[i].Action != EPSGCPUpdateAction::Keep)
+			{
+				Job->PendingDownloads++;
+			}
+		}
+
+		if (Job->PendingDownloads == 0)
+		{
+			ApplyOnBackgroundThread(Job);
+			return;
+		}
+
+		for (int32 i = 0; i < Job->Files.Num(); i++)
+		{
+			if (Job->Files[i].Action == EPSGCPUpdateAction::Keep) continue;
+
+			TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+			HttpRequest->SetVerb("GET");
+			HttpRequest->SetURL(Job->Files[i].DownloadUrl);
+			HttpRequest->OnProcessRequestComplete().BindLambda([Job, i]
+				(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+				{
+					OnDownloadFinished(Job, i, Response, bConnectedSuccessfully);
+				});
+
+			if (!HttpRequest->ProcessRequest())
+			{
+				OnDownloadFinished(Job, i, nullptr, false);
+			}
+		}
+	}
+
+	//Called once per job, also when the manifest request failed to start.
+	void OnManifestReceived(const FPSGCPUpdateJobRef& Job, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+	{
+		if (Job->bManifestReceived) return;
+		Job->bManifestReceived = true;
+
+		if (!bConnectedSuccessfully || !Response.IsValid())
+		{
+			Job->OnComplete(false, "Manifest request has failed.");
+			return;
+		}
+
+		if (Response->GetResponseCode() >= 400)
+		{
+			Job->OnComplete(false, FString::Printf(TEXT("Manifest request returned %d"), Response->GetResponseCode()));
+			return;
+		}
+
+		FString ErrorMessage;
+		if (!ParseManifest(Response->GetContentAsString(), Job.Get(), ErrorMessage))
+		{
+			Job->OnComplete(false, ErrorMessage);
+			return;
+		}
+
+		FBLambdaRunnable::RunLambdaOnDedicatedBackgroundThread([Job]()
+			{
+				FString PlanErrorMessage;
+				if (!PlanUpdate(Job.Get(), PlanErrorMessage))
+				{
+					CompleteOnGameThread(Job, false, PlanErrorMessage);
+					return;
+				}
+				FBLambdaRunnable::RunLambdaOnGameThread([Job]()
+					{
+						StartDownloads(Job);
+					});
+			});
+	}
+
+	bool ReadPatchValue(const TArray<uint8>& Patch, int64& Offset, uint64& OutValue)
+	{
+		if (Offset + (int64)sizeof(uint64) > Patch.Num()) return false;
+
+		OutValue = 0;
+		for (int32 i = 0; i < (int32)sizeof(uint64); i++)
+		{
+			OutValue |= (uint64)Patch[Offset + i] << (i * 8);
+		}
+		Offset += sizeof(uint64);
+		return true;
+	}
+
+	void WritePatchValue(TArray<uint8>& Patch, uint64 Value)
+	{
+		for (int32 i = 0; i < (int32)sizeof(uint64); i++)
+		{
+			Patch.Add((uint8)(Value >> (i * 8)));
+		}
+	}
+
+	void WritePatchInsert(TArray<uint8>& Patch, const uint8* Data, int64 Length)
+	{
+		if (Length <= 0) return;
+
+		Patch.Add(PSGCP_PATCH_OP_INSERT);
+		WritePatchValue(Patch, Length);
+		Patch.Append(Data, (int32)Length);
+	}
+
+	uint32 HashPatchBlock(const uint8* Data)
+	{
+		uint32 Hash = 0;
+		for (int32 i = 0; i < PSGCP_PATCH_BLOCK_SIZE; i++)
+		{
+			Hash = Hash * PSGCP_PATCH_HASH_BASE + Data[i];
+		}
+		return Hash;
+	}
+
+	//Release urls are relative to releases/ and keep the folder structure of the path.
+	FString MakeReleaseUrl(const FString& Folder, const FString& RelativePath, const FString& Suffix = TEXT(""))
+	{
+		TArray<FString> Segments;
+		(RelativePath + Suffix).ParseIntoArray(Segments, TEXT("/"));
+		for (FString& Segment : Segments)
+		{
+			Segment = FGenericPlatformHttp::UrlEncode(Segment);
+		}
+		return Folder + TEXT("/") + FString::Join(Segments, TEXT("/"));
+	}
+}
+
+void PSGCPProcessorUpdater::TryPatchUpdate(
+	const FString& ManifestUrl,
+	const FString& ReleasesBaseUrl,
+	const FString& InstalledFolderAbsolutePath,
+	const FString& StagingFolderAbsolutePath,
+	TFunction<void(bool bSucceed, const FString& ErrorMessage)> OnComplete)
+{
+	if (!IFileManager::Get().DirectoryExists(*InstalledFolderAbsolutePath))
+	{
+		OnComplete(false, "There is no installed version to patch.");
+		return;
+	}
+
+	FPSGCPUpdateJobRef Job = MakeShared<FPSGCPUpdateJob, ESPMode::ThreadSafe>();
+	Job->ReleasesBaseUrl = ReleasesBaseUrl;
+	Job->InstalledFolder = InstalledFolderAbsolutePath;
+	Job->StagingFolder = StagingFolderAbsolutePath;
+	Job->OnComplete = MoveTemp(OnComplete);
+
+	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetVerb("GET");
+	HttpRequest->SetURL(ManifestUrl);
+	HttpRequest->OnProcessRequestComplete().BindLambda([Job]
+		(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+		{
+			OnManifestReceived(Job, Response, bConnectedSuccessfully);
+		});
+
+	if (!HttpRequest->ProcessRequest())
+	{
+		OnManifestReceived(Job, nullptr, false);
+	}
+}
+
+bool PSGCPProcessorUpdater::PatchUpdateFromManifest(
+	const FString& ManifestJson,
+	const FString& InstalledFolderAbsolutePath,
+	const FString& StagingFolderAbsolutePath,
+	TFunctionRef<bool(const FString& Url, TArray<uint8>& OutContent)> Fetch,
+	FString& ErrorMessage)
+{
+	FPSGCPUpdateJob Job;
+	Job.InstalledFolder = InstalledFolderAbsolutePath;
+	Job.StagingFolder = StagingFolderAbsolutePath;
+
+	if (!IFileManager::Get().DirectoryExists(*InstalledFolderAbsolutePath))
+	{
+		ErrorMessage = "There is no installed version to patch.";
+		return false;
+	}
+
+	if (!ParseManifest(ManifestJson, Job, ErrorMessage) || !PlanUpdate(Job, ErrorMessage))
+	{
+		return false;
+	}
+
+	for (FPSGCPUpdateFile& File : Job.Files)
+	{
+		if (File.Action != EPSGCPUpdateAction::Keep && !Fetch(File.DownloadUrl, File.Downloaded))
+		{
+			ErrorMessage = FString::Printf(TEXT("Failed to download %s."), *File.DownloadUrl);
+			return false;
+		}
+	}
+
+	if (!ApplyUpdate(Job, ErrorMessage))
+	{
+		FPlatformFileManager::Get().GetPlatformFile().DeleteDirectoryRecursively(*StagingFolderAbsolutePath);
+		return false;
+	}
+	return true;
+}
+
+bool PSGCPProcessorUpdater::BuildRelease(
+	const FString& ReleaseFolderAbsolutePath,
+	const TArray<FString>& PreviousReleaseFolderAbsolutePaths,
+	const FString& OutputFolderAbsolutePath,
+	FString& ErrorMessage)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!PlatformFile.DirectoryExists(*ReleaseFolderAbsolutePath))
+	{
+		ErrorMessage = FString::Printf(TEXT("Release folder does not exist at %s"), *ReleaseFolderAbsolutePath);
+		return false;
+	}
+
+	//Files and patches of an older release in the output would be uploaded along with this one.
+	PlatformFile.DeleteDirectoryRecursively(*(OutputFolderAbsolutePath / TEXT("files")));
+	PlatformFile.DeleteDirectoryRecursively(*(OutputFolderAbsolutePath / TEXT("patches")));
+	if (!PlatformFile.CreateDirectoryTree(*OutputFolderAbsolutePath))
+	{
+		ErrorMessage = FString::Printf(TEXT("Failed to create the output folder at %s"), *OutputFolderAbsolutePath);
+		return false;
+	}
+
+	const FString ZipAbsolutePath = OutputFolderAbsolutePath / TEXT(PSGCP_PROCESSOR_RELEASE_ZIP_NAME);
+	const FString JournalAbsolutePath = ZipAbsolutePath + TEXT(".journal");
+	PlatformFile.DeleteFile(*ZipAbsolutePath);
+	PlatformFile.DeleteFile(*JournalAbsolutePath);
+
+	const FThreadSafeBool bCancelRequested = false;
+	bool bCancelled = false;
+	const bool bZipped = PSGCPResumableZip::CompressAll(ReleaseFolderAbsolutePath, ZipAbsolutePath, JournalAbsolutePath, bCancelRequested, bCancelled, ErrorMessage);
+	PlatformFile.DeleteFile(*JournalAbsolutePath);
+	if (!bZipped)
+	{
+		return false;
+	}
+
+	TArray<FString> ReleaseFiles;
+	IFileManager::Get().FindFilesRecursive(ReleaseFiles, *ReleaseFolderAbsolutePath, TEXT("*"), true, false);
+	ReleaseFiles.Sort();
+
+	TArray<TSharedPtr<FJsonValue>> FileValues;
+	for (FString& RelativePath : ReleaseFiles)
+	{
+		FPaths::MakePathRelativeTo(RelativePath, *(ReleaseFolderAbsolutePath / TEXT("")));
+
+		TArray<uint8> Content;
+		if (!FFileHelper::LoadFileToArray(Content, *(ReleaseFolderAbsolutePath / RelativePath)))
+		{
+			ErrorMessage = FString::Printf(TEXT("Failed to read %s."), *RelativePath);
+			return false;
+		}
+
+		const FString Sha1 = HashBuffer(Content);
+		const FString Url = MakeReleaseUrl(TEXT("files"), RelativePath);
+		if (!FFileHelper::SaveArrayToFile(Content, *(OutputFolderAbsolutePath / TEXT("files") / RelativePath)))
+		{
+			ErrorMessage = FString::Printf(TEXT("Failed to save %s."), *Url);
+			return false;
+		}
+
+		TArray<FString> PatchedSha1s;
+		TArray<TSharedPtr<FJsonValue>> PatchValues;
+		for (const FString& PreviousFolder : PreviousReleaseFolderAbsolutePaths)
+		{
+			TArray<uint8> PreviousContent;
+			if (!FFileHelper::LoadFileToArray(PreviousContent, *(PreviousFolder / RelativePath), FILEREAD_Silent)) continue;
+
+			const FString FromSha1 = HashBuffer(PreviousContent);
+			if (FromSha1 == Sha1 || PatchedSha1s.Contains(FromSha1)) continue;
+			PatchedSha1s.Add(FromSha1);
+
+			TArray<uint8> Patch;
+			PSGCPProcessorUpdater::MakeBinaryPatch(PreviousContent, Content, Patch);
+			if (Patch.Num() >= Content.Num()) continue;
+
+			const FString PatchUrl = MakeReleaseUrl(TEXT("patches"), RelativePath, FString::Printf(TEXT(".%s.patch"), *FromSha1));
+			if (!FFileHelper::SaveArrayToFile(Patch, *(OutputFolderAbsolutePath / TEXT("patches") / FString::Printf(TEXT("%s.%s.patch"), *RelativePath, *FromSha1))))
+			{
+				ErrorMessage = FString::Printf(TEXT("Failed to save %s."), *PatchUrl);
+				return false;
+			}
+
+			TSharedPtr<FJsonObject> PatchObject = MakeShareable(new FJsonObject);
+			PatchObject->SetStringField("fromSha1", FromSha1);
+			PatchObject->SetNumberField("size", Patch.Num());
+			PatchObject->SetStringField("url", PatchUrl);
+			PatchValues.Add(MakeShareable(new FJsonValueObject(PatchObject)));
+		}
+
+		TSharedPtr<FJsonObject> FileObject = MakeShareable(new FJsonObject);
+		FileObject->SetStringField("path", RelativePath);
+		FileObject->SetNumberField("size", Content.Num());
+		FileObject->SetStringField("sha1", Sha1);
+		FileObject->SetStringField("url", Url);
+		FileObject->SetArrayField("patches", PatchValues);
+		FileValues.Add(MakeShareable(new FJsonValueObject(FileObject)));
+	}
+
+	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	JsonObject->SetNumberField("zipSize", IFileManager::Get().FileSize(*ZipAbsolutePath));
+	JsonObject->SetArrayField("files", FileValues);
+
+	FString OutputString;
+	auto Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+
+	if (!FFileHelper::SaveStringToFile(OutputString, *(OutputFolderAbsolutePath / TEXT(PSGCP_PROCESSOR_RELEASE_MANIFEST_NAME))))
+	{
+		ErrorMessage = "Failed to save the manifest.";
+		return false;
+	}
+	return true;
+}
+
+void PSGCPProcessorUpdater::MakeBinaryPatch(const TArray<uint8>& Source, const TArray<uint8>& Target, TArray<uint8>& OutPatch)
+{
+	const int64 SourceSize = Source.Num();
+	const int64 TargetSize = Target.Num();
+	const uint8* SourceData = Source.GetData();
+	const uint8* TargetData = Target.GetData();
+
+	OutPatch.Reset();
+	OutPatch.Append((const uint8*)PSGCP_PATCH_MAGIC, FCStringAnsi::Strlen(PSGCP_PATCH_MAGIC));
+	WritePatchValue(OutPatch, TargetSize);
+
+	//First offset of every block hash; collisions are caught by the compare below.
+	TMap<uint32, int64> BlockOffsets;
+	BlockOffsets.Reserve((int32)(SourceSize / PSGCP_PATCH_BLOCK_SIZE));
+	for (int64 Offset = 0; Offset + PSGCP_PATCH_BLOCK_SIZE <= SourceSize; Offset += PSGCP_PATCH_BLOCK_SIZE)
+	{
+		const uint32 Hash = HashPatchBlock(SourceData + Offset);
+		if (!BlockOffsets.Contains(Hash))
+		{
+			BlockOffsets.Add(Hash, Offset);
+		}
+	}
+
+	//Weight of the byte leaving the rolling window.
+	uint32 OutgoingWeight = 1;
+	for (int32 i = 0; i < PSGCP_PATCH_BLOCK_SIZE - 1; i++)
+	{
+		OutgoingWeight *= PSGCP_PATCH_HASH_BASE;
+	}
+
+	int64 PendingStart = 0;
+	int64 Cursor = 0;
+	uint32 Hash = 0;
+	bool bHashValid = false;
+
+	while (BlockOffsets.Num() > 0 && Cursor + PSGCP_PATCH_BLOCK_SIZE <= TargetSize)
+	{
+		if (!bHashValid)
+		{
+			Hash = HashPatchBlock(TargetData + Cursor);
+			bHashValid = true;
+		}
+
+		const int64* SourceOffset = BlockOffsets.Find(Hash);
+		if (SourceOffset && FMemory::Memcmp(SourceData + *SourceOffset, TargetData + Cursor, PSGCP_PATCH_BLOCK_SIZE) == 0)
+		{
+			int64 MatchStart = *SourceOffset;
+			int64 Length = PSGCP_PATCH_BLOCK_SIZE;
+			while (Cursor + Length < TargetSize && MatchStart + Length < SourceSize && TargetData[Cursor + Length] == SourceData[MatchStart + Length])
+			{
+				Length++;
+			}
+
+			//The match may also start inside the bytes that were going to be inserted.
+			int64 Back = 0;
+			while (Cursor - Back > PendingStart && MatchStart - Back > 0 && TargetData[Cursor - Back - 1] == SourceData[MatchStart - Back - 1])
+			{
+				Back++;
+			}
+
+			WritePatchInsert(OutPatch, TargetData + PendingStart, Cursor - Back - PendingStart);
+			OutPatch.Add(PSGCP_PATCH_OP_COPY);
+			WritePatchValue(OutPatch, MatchStart - Back);
+			WritePatchValue(OutPatch, Length + Back);
+
+			Cursor += Length;
+			PendingStart = Cursor;
+			bHashValid = false;
+		}
+		else
+		{
+			if (Cursor + PSGCP_PATCH_BLOCK_SIZE < TargetSize)
+			{
+				Hash = (Hash - TargetData[Cursor] * OutgoingWeight) * PSGCP_PATCH_HASH_BASE + TargetData[Cursor + PSGCP_PATCH_BLOCK_SIZE];
+			}
+			Cursor++;
+		}
+	}
+
+	WritePatchInsert(OutPatch, TargetData + PendingStart, TargetSize - PendingStart);
+	OutPatch.Add(PSGCP_PATCH_OP_END);
+}
+
+bool PSGCPProcessorUpdater::ApplyBinaryPatch(const TArray<uint8>& Source, const TArray<uint8>& Patch, int64 ExpectedTargetSize, TArray<uint8>& OutTarget, FString& ErrorMessage)
+{
+	const int64 MagicLength = FCStringAnsi::Strlen(PSGCP_PATCH_MAGIC);
+	int64 Offset = MagicLength;
+	uint64 TargetSize = 0;
+
+	if (Patch.Num() < MagicLength
+		|| FMemory::Memcmp(Patch.GetData(), PSGCP_PATCH_MAGIC, MagicLength) != 0
+		|| !ReadPatchValue(Patch, Offset, TargetSize)
+		|| TargetSize > (uint64)MAX_int32)
+	{
+		ErrorMessage = "Patch header is invalid.";
+		return false;
+	}
+
+	//The header is not trusted with the allocation below.
+	if (TargetSize != (uint64)ExpectedTargetSize)
+	{
+		ErrorMessage = FString::Printf(TEXT("Patch produces %llu bytes instead of %lld."), TargetSize, ExpectedTargetSize);
+		return false;
+	}
+
+	OutTarget.Reset((int32)TargetSize);
+
+	while (true)
+	{
+		if (Offset >= Patch.Num())
+		{
+			ErrorMessage = "Patch is truncated.";
+			return false;
+		}
+
+		const uint8 Op = Patch[Offset++];
+		if (Op == PSGCP_PATCH_OP_END) break;
+
+		uint64 First = 0;
+		uint64 Length = 0;
+
+		if (Op == PSGCP_PATCH_OP_COPY)
+		{
+			if (!ReadPatchValue(Patch, Offset, First) || !ReadPatchValue(Patch, Offset, Length)
+				|| First > (uint64)Source.Num() || Length > (uint64)Source.Num() - First
+				|| Length > TargetSize - OutTarget.Num())
+			{
+				ErrorMessage = "Patch copies out of bounds.";
+				return false;
+			}
+			OutTarget.Append(Source.GetData() + First, (int32)Length);
+		}
+		else if (Op == PSGCP_PATCH_OP_INSERT)
+		{
+			if (!ReadPatchValue(Patch, Offset, Length)
+				|| Length > (uint64)(Patch.Num() - Offset)
+				|| Length > TargetSize - OutTarget.Num())
+			{
+				ErrorMessage = "Patch inserts out of bounds.";
+				return false;
+			}
+			OutTarget.Append(Patch.GetData() + Offset, (int32)Length);
+			Offset += Length;
+		}
+		else
+		{
+			ErrorMessage = FString::Printf(TEXT("Patch has an unknown op %d."), Op);
+			return false;
+		}
+	}
+
+	if ((uint64)OutTarget.Num() != TargetSize)
+	{
+		ErrorMessage = "Patch result has an unexpected size.";
+		return false;
+	}
+	return true;
+}
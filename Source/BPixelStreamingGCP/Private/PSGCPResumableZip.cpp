@@ -0,0 +1,510 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "PSGCPResumableZip.h"
+#include "PSGCPCodec.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+#define PSGCP_ZIP_JOURNAL_MAGIC "PSGCPZIP"
+#define PSGCP_ZIP_JOURNAL_VERSION 1
+#define PSGCP_ZIP_BUFFER_SIZE (1024 * 1024)
+#define PSGCP_ZIP_CHECKPOINT_BYTES (64ull * 1024 * 1024)
+#define PSGCP_ZIP_CHECKPOINT_SECONDS 2.0
+
+namespace
+{
+	struct FPSGCPZipSourceFile
+	{
+		FString AbsolutePath;
+		FString RelativePath;
+		int64 Size = 0;
+		FDateTime TimeStamp;
+	};
+
+	struct FPSGCPZipEntry
+	{
+		int32 Index = 0;
+		uint32 Crc = 0;
+		uint64 CompressedSize = 0;
+		uint64 UncompressedSize = 0;
+		uint64 LocalHeaderOffset = 0;
+		uint64 EndOffset = 0;
+		uint32 DosTime = 0;
+	};
+
+	enum class EPSGCPZipEntryResult : uint8
+	{
+		Succeed,
+		Failed,
+		Cancelled
+	};
+
+	void AppendLE(TArray<uint8>& Out, uint64 Value, int32 ByteCount)
+	{
+		for (int32 i = 0; i < ByteCount; i++)
+		{
+			Out.Add((uint8)((Value >> (i * 8)) & 0xFF));
+		}
+	}
+
+	uint32 ToDosTime(const FDateTime& TimeStamp)
+	{
+		const int32 Year = FMath::Clamp(TimeStamp.GetYear(), 1980, 2107);
+		return ((uint32)(Year - 1980) << 25)
+			| ((uint32)TimeStamp.GetMonth() << 21)
+			| ((uint32)TimeStamp.GetDay() << 16)
+			| ((uint32)TimeStamp.GetHour() << 11)
+			| ((uint32)TimeStamp.GetMinute() << 5)
+			| ((uint32)TimeStamp.GetSecond() >> 1);
+	}
+
+	bool WriteBytes(IFileHandle* Handle, const TArray<uint8>& Bytes)
+	{
+		return Bytes.Num() == 0 || Handle->Write(Bytes.GetData(), Bytes.Num());
+	}
+
+	bool WriteLine(IFileHandle* Handle, const FString& Line)
+	{
+		FTCHARToUTF8 Converted(*(Line + TEXT("\n")));
+		return Handle->Write((const uint8*)Converted.Get(), Converted.Length());
+	}
+
+	//Sizes are always stored in the Zip64 extra field; so the header length does not change when it is rewritten with the final values.
+	TArray<uint8> BuildLocalHeader(const FString& RelativePath, const FPSGCPZipEntry& Entry)
+	{
+		FTCHARToUTF8 Name(*RelativePath);
+
+		TArray<uint8> Header;
+		AppendLE(Header, 0x04034b50, 4);
+		AppendLE(Header, 45, 2);
+		AppendLE(Header, 0x0800, 2);
+		AppendLE(Header, Z_DEFLATED, 2);
+		AppendLE(Header, Entry.DosTime, 4);
+		AppendLE(Header, Entry.Crc, 4);
+		AppendLE(Header, 0xFFFFFFFF, 4);
+		AppendLE(Header, 0xFFFFFFFF, 4);
+		AppendLE(Header, Name.Length(), 2);
+		AppendLE(Header, 20, 2);
+		Header.Append((const uint8*)Name.Get(), Name.Length());
+		AppendLE(Header, 0x0001, 2);
+		AppendLE(Header, 16, 2);
+		AppendLE(Header, Entry.UncompressedSize, 8);
+		AppendLE(Header, Entry.CompressedSize, 8);
+		return Header;
+	}
+
+	void AppendCentralDirectoryHeader(TArray<uint8>& Out, const FString& RelativePath, const FPSGCPZipEntry& Entry)
+	{
+		FTCHARToUTF8 Name(*RelativePath);
+
+		AppendLE(Out, 0x02014b50, 4);
+		AppendLE(Out, 45, 2);
+		AppendLE(Out, 45, 2);
+		AppendLE(Out, 0x0800, 2);
+		AppendLE(Out, Z_DEFLATED, 2);
+		AppendLE(Out, Entry.DosTime, 4);
+		AppendLE(Out, Entry.Crc, 4);
+		AppendLE(Out, 0xFFFFFFFF, 4);
+		AppendLE(Out, 0xFFFFFFFF, 4);
+		AppendLE(Out, Name.Length(), 2);
+		AppendLE(Out, 28, 2);
+		AppendLE(Out, 0, 2);
+		AppendLE(Out, 0, 2);
+		AppendLE(Out, 0, 2);
+		AppendLE(Out, 0, 4);
+		AppendLE(Out, 0xFFFFFFFF, 4);
+		Out.Append((const uint8*)Name.Get(), Name.Length());
+		AppendLE(Out, 0x0001, 2);
+		AppendLE(Out, 24, 2);
+		AppendLE(Out, Entry.UncompressedSize, 8);
+		AppendLE(Out, Entry.CompressedSize, 8);
+		AppendLE(Out, Entry.LocalHeaderOffset, 8);
+	}
+
+	void AppendEndOfCentralDirectory(TArray<uint8>& Out, uint64 EntryCount, uint64 CentralDirectoryOffset, uint64 CentralDirectorySize)
+	{
+		const uint64 Zip64EndOffset = CentralDirectoryOffset + CentralDirectorySize;
+
+		AppendLE(Out, 0x06064b50, 4);
+		AppendLE(Out, 44, 8);
+		AppendLE(Out, 45, 2);
+		AppendLE(Out, 45, 2);
+		AppendLE(Out, 0, 4);
+		AppendLE(Out, 0, 4);
+		AppendLE(Out, EntryCount, 8);
+		AppendLE(Out, EntryCount, 8);
+		AppendLE(Out, CentralDirectorySize, 8);
+		AppendLE(Out, CentralDirectoryOffset, 8);
+
+		AppendLE(Out, 0x07064b50, 4);
+		AppendLE(Out, 0, 4);
+		AppendLE(Out, Zip64EndOffset, 8);
+		AppendLE(Out, 1, 4);
+
+		AppendLE(Out, 0x06054b50, 4);
+		AppendLE(Out, 0, 2);
+		AppendLE(Out, 0, 2);
+		AppendLE(Out, FMath::Min<uint64>(EntryCount, 0xFFFF), 2);
+		AppendLE(Out, FMath::Min<uint64>(EntryCount, 0xFFFF), 2);
+		AppendLE(Out, FMath::Min<uint64>(CentralDirectorySize, 0xFFFFFFFF), 4);
+		AppendLE(Out, 0xFFFFFFFF, 4);
+		AppendLE(Out, 0, 2);
+	}
+
+	FString ListSourceFiles(const FString& SourceFolderAbsolutePath, TArray<FPSGCPZipSourceFile>& OutFiles)
+	{
+		FString Root = SourceFolderAbsolutePath;
+		FPaths::NormalizeDirectoryName(Root);
+
+		TArray<FString> FoundFiles;
+		IFileManager::Get().FindFilesRecursive(FoundFiles, *Root, TEXT("*"), true, false);
+		FoundFiles.Sort();
+
+		FSHA1 Hasher;
+		FTCHARToUTF8 RootUtf8(*Root);
+		Hasher.Update((const uint8*)RootUtf8.Get(), RootUtf8.Length());
+
+		for (const FString& FoundFile : FoundFiles)
+		{
+			FPSGCPZipSourceFile& File = OutFiles.AddDefaulted_GetRef();
+			File.AbsolutePath = FoundFile;
+			File.RelativePath = FoundFile;
+			FPaths::NormalizeFilename(File.RelativePath);
+			File.RelativePath.RemoveFromStart(Root + TEXT("/"));
+			File.Size = IFileManager::Get().FileSize(*FoundFile);
+			File.TimeStamp = IFileManager::Get().GetTimeStamp(*FoundFile);
+
+			FTCHARToUTF8 Line(*FString::Printf(TEXT("\n%s|%lld|%lld"), *File.RelativePath, File.Size, File.TimeStamp.GetTicks()));
+			Hasher.Update((const uint8*)Line.Get(), Line.Length());
+		}
+		Hasher.Final();
+
+		uint8 Hash[FSHA1::DigestSize];
+		Hasher.GetHash(Hash);
+
+		ANSICHAR HashHex[FSHA1::DigestSize * 2 + 1];
+		PSGCPCodec::HexEncode(Hash, FSHA1::DigestSize, HashHex, true);
+		HashHex[FSHA1::DigestSize * 2] = '\0';
+		return FString(HashHex);
+	}
+
+	//Returns the checkpointed entries; a torn or unknown trailing line ends the journal.
+	void LoadJournal(const FString& JournalAbsolutePath, const FString& Fingerprint, const TArray<FPSGCPZipSourceFile>& Files, TArray<FPSGCPZipEntry>& OutEntries, int64& OutCompletedZipSize)
+	{
+		OutCompletedZipSize = -1;
+
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *JournalAbsolutePath) || Lines.Num() == 0)
+		{
+			return;
+		}
+
+		TArray<FString> Fields;
+		Lines[0].ParseIntoArray(Fields, TEXT("\t"), false);
+		if (Fields.Num() != 3
+			|| Fields[0] != TEXT(PSGCP_ZIP_JOURNAL_MAGIC)
+			|| FCString::Atoi(*Fields[1]) != PSGCP_ZIP_JOURNAL_VERSION
+			|| Fields[2] != Fingerprint)
+		{
+			return;
+		}
+
+		for (int32 i = 1; i < Lines.Num(); i++)
+		{
+			Lines[i].ParseIntoArray(Fields, TEXT("\t"), false);
+
+			if (Fields.Num() == 2 && Fields[0] == TEXT("C"))
+			{
+				if (OutEntries.Num() == Files.Num())
+				{
+					OutCompletedZipSize = FCString::Strtoi64(*Fields[1], nullptr, 10);
+				}
+				return;
+			}
+
+			if (Fields.Num() != 9 || Fields[0] != TEXT("E"))
+			{
+				return;
+			}
+
+			FPSGCPZipEntry Entry;
+			Entry.Index = FCString::Atoi(*Fields[1]);
+			if (Entry.Index != OutEntries.Num() || !Files.IsValidIndex(Entry.Index) || Files[Entry.Index].RelativePath != Fields[8])
+			{
+				return;
+			}
+			Entry.Crc = (uint32)FCString::Strtoui64(*Fields[2], nullptr, 10);
+			Entry.CompressedSize = FCString::Strtoui64(*Fields[3], nullptr, 10);
+			Entry.UncompressedSize = FCString::Strtoui64(*Fields[4], nullptr, 10);
+			Entry.LocalHeaderOffset = FCString::Strtoui64(*Fields[5], nullptr, 10);
+			Entry.EndOffset = FCString::Strtoui64(*Fields[6], nullptr, 10);
+			Entry.DosTime = (uint32)FCString::Strtoui64(*Fields[7], nullptr, 10);
+			OutEntries.Add(Entry);
+		}
+	}
+
+	FString JournalEntryLine(const FPSGCPZipEntry& Entry, const FPSGCPZipSourceFile& File)
+	{
+		return FString::Printf(TEXT("E\t%d\t%u\t%llu\t%llu\t%llu\t%llu\t%u\t%s"),
+			Entry.Index, Entry.Crc, Entry.CompressedSize, Entry.UncompressedSize, Entry.LocalHeaderOffset, Entry.EndOffset, Entry.DosTime, *File.RelativePath);
+	}
+
+	EPSGCPZipEntryResult CompressEntry(IFileHandle* Zip, const FPSGCPZipSourceFile& File, FPSGCPZipEntry& Entry, TArray<uint8>& InBuffer, TArray<uint8>& OutBuffer, const FThreadSafeBool& bCancelRequested, FString& ErrorMessage)
+	{
+		TUniquePtr<IFileHandle> Source(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*File.AbsolutePath));
+		if (!Source.IsValid())
+		{
+			ErrorMessage = FString::Printf(TEXT("Failed to open %s for reading."), *File.AbsolutePath);
+			return EPSGCPZipEntryResult::Failed;
+		}
+
+		Entry.DosTime = ToDosTime(File.TimeStamp);
+		Entry.LocalHeaderOffset = Zip->Tell();
+
+		if (!WriteBytes(Zip, BuildLocalHeader(File.RelativePath, Entry)))
+		{
+			ErrorMessage = TEXT("Failed to write to the zip file.");
+			return EPSGCPZipEntryResult::Failed;
+		}
+
+		z_stream Stream;
+		FMemory::Memzero(Stream);
+		if (deflateInit2(&Stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			ErrorMessage = TEXT("Failed to initialize the deflate stream.");
+			return EPSGCPZipEntryResult::Failed;
+		}
+
+		uLong Crc = crc32(0L, Z_NULL, 0);
+		int64 Remaining = Source->Size();
+		EPSGCPZipEntryResult Result = EPSGCPZipEntryResult::Succeed;
+
+		while (Result == EPSGCPZipEntryResult::Succeed)
+		{
+			if (bCancelRequested)
+			{
+				Result = EPSGCPZipEntryResult::Cancelled;
+				break;
+			}
+
+			const int64 ReadSize = FMath::Min<int64>(Remaining, InBuffer.Num());
+			if (ReadSize > 0 && !Source->Read(InBuffer.GetData(), ReadSize))
+			{
+				ErrorMessage = FString::Printf(TEXT("Failed to read %s."), *File.AbsolutePath);
+				Result = EPSGCPZipEntryResult::Failed;
+				break;
+			}
+			Remaining -= ReadSize;
+			Entry.UncompressedSize += ReadSize;
+			Crc = crc32(Crc, InBuffer.GetData(), (uInt)ReadSize);
+
+			const int32 FlushMode = Remaining > 0 ? Z_NO_FLUSH : Z_FINISH;
+			Stream.next_in = InBuffer.GetData();
+			Stream.avail_in = (uInt)ReadSize;
+
+			do
+			{
+				Stream.next_out = OutBuffer.GetData();
+				Stream.avail_out = (uInt)OutBuffer.Num();
+
+				if (deflate(&Stream, FlushMode) == Z_STREAM_ERROR)
+				{
+					ErrorMessage = FString::Printf(TEXT("Failed to compress %s."), *File.AbsolutePath);
+					Result = EPSGCPZipEntryResult::Failed;
+					break;
+				}
+
+				const int64 Produced = OutBuffer.Num() - Stream.avail_out;
+				if (Produced > 0 && !Zip->Write(OutBuffer.GetData(), Produced))
+				{
+					ErrorMessage = TEXT("Failed to write to the zip file.");
+					Result = EPSGCPZipEntryResult::Failed;
+					break;
+				}
+				Entry.CompressedSize += Produced;
+			} while (Stream.avail_out == 0);
+
+			if (FlushMode == Z_FINISH) break;
+		}
+		deflateEnd(&Stream);
+
+		if (Result != EPSGCPZipEntryResult::Succeed)
+		{
+			return Result;
+		}
+
+		Entry.Crc = (uint32)Crc;
+		Entry.EndOffset = Zip->Tell();
+
+		if (!Zip->Seek(Entry.LocalHeaderOffset)
+			|| !WriteBytes(Zip, BuildLocalHeader(File.RelativePath, Entry))
+			|| !Zip->Seek(Entry.EndOffset))
+		{
+			ErrorMessage = TEXT("Failed to finalize the zip entry header.");
+			return EPSGCPZipEntryResult::Failed;
+		}
+		return EPSGCPZipEntryResult::Succeed;
+	}
+}
+
+bool PSGCPResumableZip::CompressAll(
+	const FString& SourceFolderAbsolutePath,
+	const FString& ZipAbsolutePath,
+	const FString& JournalAbsolutePath,
+	const FThreadSafeBool& bCancelRequested,
+	bool& bOutCancelled,
+	FString& ErrorMessage)
+{
+	bOutCancelled = false;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TArray<FPSGCPZipSourceFile> Files;
+	const FString Fingerprint = ListSourceFiles(SourceFolderAbsolutePath, Files);
+
+	TArray<FPSGCPZipEntry> Entries;
+	int64 CompletedZipSize = -1;
+	LoadJournal(JournalAbsolutePath, Fingerprint, Files, Entries, CompletedZipSize);
+
+	if (CompletedZipSize >= 0 && PlatformFile.FileSize(*ZipAbsolutePath) == CompletedZipSize)
+	{
+		return true;
+	}
+
+	TUniquePtr<IFileHandle> Zip;
+	bool bResumed = false;
+
+	if (Entries.Num() > 0 && PlatformFile.FileSize(*ZipAbsolutePath) >= (int64)Entries.Last().EndOffset)
+	{
+		//Anything after the last checkpoint (a partial entry or an old central directory) is discarded.
+		Zip.Reset(PlatformFile.OpenWrite(*ZipAbsolutePath, true, false));
+		bResumed = Zip.IsValid()
+			&& Zip->Truncate(Entries.Last().EndOffset)
+			&& Zip->Seek(Entries.Last().EndOffset);
+	}
+
+	if (!bResumed)
+	{
+		Zip.Reset();
+		Entries.Reset();
+		PlatformFile.DeleteFile(*ZipAbsolutePath);
+		PlatformFile.DeleteFile(*JournalAbsolutePath);
+		Zip.Reset(PlatformFile.OpenWrite(*ZipAbsolutePath, false, false));
+	}
+
+	//The journal is rewritten with only the entries that were loaded; appending after a torn or unknown line would make
+	//every later load stop at that line again.
+	TUniquePtr<IFileHandle> Journal(PlatformFile.OpenWrite(*JournalAbsolutePath, false, false));
+
+	if (!Zip.IsValid() || !Journal.IsValid())
+	{
+		ErrorMessage = FString::Printf(TEXT("Failed to open %s for writing."), Zip.IsValid() ? *JournalAbsolutePath : *ZipAbsolutePath);
+		return false;
+	}
+
+	FString JournalPrefix = FString::Printf(TEXT("%s\t%d\t%s"), TEXT(PSGCP_ZIP_JOURNAL_MAGIC), PSGCP_ZIP_JOURNAL_VERSION, *Fingerprint);
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		JournalPrefix += TEXT("\n") + JournalEntryLine(Entries[i], Files[i]);
+	}
+
+	if (!WriteLine(Journal.Get(), JournalPrefix) || !Journal->Flush())
+	{
+		ErrorMessage = TEXT("Failed to write to the journal file.");
+		return false;
+	}
+
+	//Journal lines are only written once the zip data they describe has been flushed.
+	int32 CheckpointedCount = Entries.Num();
+	uint64 CheckpointedOffset = Entries.Num() > 0 ? Entries.Last().EndOffset : 0;
+	double CheckpointedTime = FPlatformTime::Seconds();
+
+	auto Checkpoint = [&]() -> bool
+	{
+		if (CheckpointedCount == Entries.Num()) return true;
+
+		if (!Zip->Flush()) return false;
+
+		FString Lines;
+		for (int32 i = CheckpointedCount; i < Entries.Num(); i++)
+		{
+			Lines += JournalEntryLine(Entries[i], Files[i]) + TEXT("\n");
+		}
+		Lines.RemoveFromEnd(TEXT("\n"));
+
+		if (!WriteLine(Journal.Get(), Lines) || !Journal->Flush()) return false;
+
+		CheckpointedCount = Entries.Num();
+		CheckpointedOffset = Entries.Last().EndOffset;
+		CheckpointedTime = FPlatformTime::Seconds();
+		return true;
+	};
+
+	TArray<uint8> InBuffer;
+	TArray<uint8> OutBuffer;
+	InBuffer.SetNumUninitialized(PSGCP_ZIP_BUFFER_SIZE);
+	OutBuffer.SetNumUninitialized(PSGCP_ZIP_BUFFER_SIZE);
+
+	for (int32 i = Entries.Num(); i < Files.Num(); i++)
+	{
+		FPSGCPZipEntry Entry;
+		Entry.Index = i;
+
+		const EPSGCPZipEntryResult Result = CompressEntry(Zip.Get(), Files[i], Entry, InBuffer, OutBuffer, bCancelRequested, ErrorMessage);
+		if (Result != EPSGCPZipEntryResult::Succeed)
+		{
+			Checkpoint();
+			bOutCancelled = Result == EPSGCPZipEntryResult::Cancelled;
+			if (bOutCancelled)
+			{
+				ErrorMessage = TEXT("Compression has been cancelled; it will continue from the last checkpoint on the next run.");
+			}
+			return false;
+		}
+		Entries.Add(Entry);
+
+		if ((Entry.EndOffset - CheckpointedOffset) >= PSGCP_ZIP_CHECKPOINT_BYTES
+			|| (FPlatformTime::Seconds() - CheckpointedTime) >= PSGCP_ZIP_CHECKPOINT_SECONDS)
+		{
+			if (!Checkpoint())
+			{
+				ErrorMessage = TEXT("Failed to write the checkpoint.");
+				return false;
+			}
+		}
+	}
+
+	const uint64 CentralDirectoryOffset = Zip->Tell();
+
+	TArray<uint8> CentralDirectory;
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		AppendCentralDirectoryHeader(CentralDirectory, Files[i].RelativePath, Entries[i]);
+	}
+	const uint64 CentralDirectorySize = CentralDirectory.Num();
+	AppendEndOfCentralDirectory(CentralDirectory, Entries.Num(), CentralDirectoryOffset, CentralDirectorySize);
+
+	if (!WriteBytes(Zip.Get(), CentralDirectory) || !Checkpoint())
+	{
+		ErrorMessage = TEXT("Failed to finalize the zip file.");
+		return false;
+	}
+
+	const int64 ZipSize = Zip->Tell();
+	Zip.Reset();
+
+	if (!WriteLine(Journal.Get(), FString::Printf(TEXT("C\t%lld"), ZipSize)) || !Journal->Flush())
+	{
+		ErrorMessage = TEXT("Failed to write to the journal file.");
+		return false;
+	}
+	return true;
+}
@@ -8,18 +8,31 @@
 #include "Misc/FileHelper.h"
 #include "JsonUtilities.h"
 #include "Misc/Paths.h"
+#include "Containers/Ticker.h"
 #include "BLambdaRunnable.h"
 #include "BZipFile.h"
+#include "PSGCPResumableZip.h"
+#include "PSGCPCodec.h"
+#include "PSGCPProcessorUpdater.h"
+#include "PSGCPProcessLog.h"
 #include "Runtime/Online/HTTP/Public/Http.h"
 
 #define SAVE_FILE_PATH FPaths::ProjectPluginsDir() + "BPixelStreamingGCP/Saved/LastPSGCProjectInfo.json"
 
-#define B_UNREAL_PS_PLUGIN_PROCESSOR_URL "https://storage.googleapis.com/{{BUCKET_NAME}}/releases/ps_unreal_plugin_processor.zip"
+#define B_UNREAL_PS_PLUGIN_PROCESSOR_RELEASES_URL "https://storage.googleapis.com/{{BUCKET_NAME}}/releases/"
+#define B_UNREAL_PS_PLUGIN_PROCESSOR_URL B_UNREAL_PS_PLUGIN_PROCESSOR_RELEASES_URL PSGCP_PROCESSOR_RELEASE_ZIP_NAME
+#define B_UNREAL_PS_PLUGIN_PROCESSOR_MANIFEST_URL B_UNREAL_PS_PLUGIN_PROCESSOR_RELEASES_URL PSGCP_PROCESSOR_RELEASE_MANIFEST_NAME
 #define B_UNREAL_PS_PLUGIN_PROCESSOR_LOCAL_RELATIVE_PATH FPaths::ProjectPluginsDir() + "BPixelStreamingGCP/Saved/ps_unreal_plugin_processor.zip"
 #define B_UNREAL_PS_PLUGIN_PROCESSOR_EXTRACT_FOLDER_LOCAL_RELATIVE_PATH FPaths::ProjectPluginsDir() + "BPixelStreamingGCP/Saved/ps_unreal_plugin_processor"
+#define B_UNREAL_PS_PLUGIN_PROCESSOR_STAGING_FOLDER_LOCAL_RELATIVE_PATH FPaths::ProjectPluginsDir() + "BPixelStreamingGCP/Saved/ps_unreal_plugin_processor_staging"
 #define B_UNREAL_PS_PLUGIN_PROCESSOR_EXE_LOCAL_RELATIVE_PATH_UPON_EXTRACT FPaths::ProjectPluginsDir() + "BPixelStreamingGCP/Saved/ps_unreal_plugin_processor/PixelStreamingUnrealEditorPluginProcessor.exe"
 
+#define B_UNREAL_PS_PROCESS_LOGS_FOLDER_LOCAL_RELATIVE_PATH FPaths::ProjectPluginsDir() + "BPixelStreamingGCP/Saved/ProcessLogs"
+#define B_UNREAL_PS_PROCESS_LOGS_KEEP_COUNT 32
+#define B_UNREAL_PS_PROCESS_EXIT_MAX_DELAY_SECONDS 0.5
+
 #define B_UNREAL_PACKAGED_PS_APPLICATION_ZIP_LOCAL_RELATIVE_PATH FPaths::ProjectPluginsDir() + "BPixelStreamingGCP/Saved/ps_unreal_packaged_application.zip"
+#define B_UNREAL_PACKAGED_PS_APPLICATION_ZIP_JOURNAL_LOCAL_RELATIVE_PATH FPaths::ProjectPluginsDir() + "BPixelStreamingGCP/Saved/ps_unreal_packaged_application.zip.journal"
 
 void UPSGCPWidgetBlueprintLibrary::SelectPackageDirectory(const FPSGCPSelectPackageDirectoryResult& Callback)
 {
@@ -97,7 +110,14 @@ bool UPSGCPWidgetBlueprintLibrary::TryLoadingGCProjectInfoFromSavedPath(FString&
 
 FString UPSGCPWidgetBlueprintLibrary::HexEncode(const FString& Input)
 {
-	return BytesToHex((uint8*)TCHAR_TO_UTF8(*Input), Input.Len());
+	FTCHARToUTF8 Utf8Input(*Input);
+
+	TArray<ANSICHAR, TInlineAllocator<512>> Encoded;
+	Encoded.SetNumUninitialized(PSGCPCodec::HexEncodedLength(Utf8Input.Length()) + 1);
+	PSGCPCodec::HexEncode((const uint8*)Utf8Input.Get(), Utf8Input.Length(), Encoded.GetData(), true);
+	Encoded.Last() = '\0';
+
+	return FString(Encoded.GetData());
 }
 
 bool UPSGCPWidgetBlueprintLibrary::CreateHiddenProcess(
@@ -108,6 +128,19 @@ bool UPSGCPWidgetBlueprintLibrary::CreateHiddenProcess(
 	int32& ExitCode,
 	PS_GCP_PROCESS_EXEC& Exec,
 	FLatentActionInfo LatentInfo)
+{
+	return CreateHiddenProcessWithOutputHook(ProcessHandle, ProgramAbsolutePath, CommandlineArgs, ReadMessage, ExitCode, Exec, nullptr, LatentInfo);
+}
+
+bool UPSGCPWidgetBlueprintLibrary::CreateHiddenProcessWithOutputHook(
+	FProcessHandleWrapper& ProcessHandle,
+	const FString& ProgramAbsolutePath,
+	const TArray<FString>& CommandlineArgs,
+	FString& ReadMessage,
+	int32& ExitCode,
+	PS_GCP_PROCESS_EXEC& Exec,
+	TFunction<void(const TArray<uint8>& Output)> OnOutput,
+	FLatentActionInfo LatentInfo)
 {
 	bool* DoneIf = new bool(false);
 	bool* TriggerUndoneIf = new bool(false);
@@ -147,44 +180,88 @@ bool UPSGCPWidgetBlueprintLibrary::CreateHiddenProcess(
 
 	if (FPlatformProcess::IsProcRunning((FProcHandle&)ProcessHandle.ProcessHandle))
 	{
-		FBLambdaRunnable::RunLambdaOnDedicatedBackgroundThread([ProcessHandle, DoneIf, TriggerUndoneIf, ReadMessagePtr, ExitCodePtr, ExecPtr]()
+		FString LogsFolderAbsolutePath = FPaths::ConvertRelativePathToFull(FString(B_UNREAL_PS_PROCESS_LOGS_FOLDER_LOCAL_RELATIVE_PATH));
+		//Leaves room for the log created below.
+		PSGCPProcessLog::PruneLogs(LogsFolderAbsolutePath, B_UNREAL_PS_PROCESS_LOGS_KEEP_COUNT - 1);
+
+		FString LogErrorMessage;
+		PSGCPProcessLog::FPtr Log = PSGCPProcessLog::Create(
+			LogsFolderAbsolutePath,
+			FString::Printf(TEXT("%s_%s_%u"), *FDateTime::Now().ToString(), *FPaths::GetBaseFilename(ProgramAbsolutePath), UProcessID),
+			LogErrorMessage);
+		if (!Log.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UPSGCPWidgetBlueprintLibrary::CreateHiddenProcess: Output will not be logged. %s"), *LogErrorMessage);
+		}
+		ProcessHandle.LogName = Log.IsValid() ? Log->GetName() : FString();
+
+		FBLambdaRunnable::RunLambdaOnDedicatedBackgroundThread([ProcessHandle, Log, OnOutput, DoneIf, TriggerUndoneIf, ReadMessagePtr, ExitCodePtr, ExecPtr]()
 			{
+				auto ForwardOutput = [ProcessHandle, Log, &OnOutput, TriggerUndoneIf, ReadMessagePtr, ExecPtr](const TArray<uint8>& BinaryData)
+				{
+					if (OnOutput)
+					{
+						OnOutput(BinaryData);
+					}
+					if (Log.IsValid())
+					{
+						Log->Append(BinaryData.GetData(), BinaryData.Num());
+					}
+
+					//The pipe data is not null terminated.
+					FUTF8ToTCHAR Converted((const ANSICHAR*)BinaryData.GetData(), BinaryData.Num());
+					FString Stringified = FString(Converted.Length(), Converted.Get());
+					FBLambdaRunnable::RunLambdaOnGameThread([ProcessHandle, Stringified, TriggerUndoneIf, ReadMessagePtr, ExecPtr]()
+						{
+							*ExecPtr = PS_GCP_PROCESS_EXEC::DataAvailable;
+							*ReadMessagePtr = Stringified;
+							*TriggerUndoneIf = true;
+						});
+				};
+
 				while (FPlatformProcess::IsProcRunning((FProcHandle&)ProcessHandle.ProcessHandle))
 				{
 					TArray<uint8> BinaryData;
 					FPlatformProcess::ReadPipeToArray(ProcessHandle.ReadPipe, BinaryData);
 					if (BinaryData.Num() > 0)
 					{
-						FString Stringified = FString(UTF8_TO_TCHAR(BinaryData.GetData()));
-						FBLambdaRunnable::RunLambdaOnGameThread([ProcessHandle, Stringified, TriggerUndoneIf, ReadMessagePtr, ExecPtr]()
-							{
-								*ExecPtr = PS_GCP_PROCESS_EXEC::DataAvailable;
-								*ReadMessagePtr = Stringified;
-								*TriggerUndoneIf = true;
-							});
+						ForwardOutput(BinaryData);
 					}
 				}
-				FBLambdaRunnable::RunLambdaOnGameThread([ProcessHandle, DoneIf, ExitCodePtr, ExecPtr]()
+
+				//Output written right before the exit is still in the pipe.
+				while (true)
+				{
+					TArray<uint8> BinaryData;
+					FPlatformProcess::ReadPipeToArray(ProcessHandle.ReadPipe, BinaryData);
+					if (BinaryData.Num() == 0) break;
+
+					ForwardOutput(BinaryData);
+				}
+
+				if (Log.IsValid())
+				{
+					Log->Close();
+				}
+				FBLambdaRunnable::RunLambdaOnGameThread([ProcessHandle, DoneIf, TriggerUndoneIf, ExitCodePtr, ExecPtr]()
 					{
-						if (UWorld* EdWorld = GEditor->GetEditorWorldContext().World())
-						{
-							if (EdWorld->IsValidLowLevel() && !EdWorld->IsPendingKillOrUnreachable())
+						//ProcessExited overwrites Exec, so it waits until the last DataAvailable is triggered; an action that is gone never clears it.
+						const double ExitTime = FPlatformTime::Seconds();
+						FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([ProcessHandle, DoneIf, TriggerUndoneIf, ExitCodePtr, ExecPtr, ExitTime](float DeltaTime)
 							{
-								FTimerHandle TimerHandle;
-								FTimerDelegate TimerDelegate;
-
-								TimerDelegate.BindLambda([ProcessHandle, DoneIf, ExitCodePtr, ExecPtr]()
-									{
-										*ExecPtr = PS_GCP_PROCESS_EXEC::ProcessExited;
-										if (!FPlatformProcess::GetProcReturnCode((FProcHandle&)ProcessHandle.ProcessHandle, ExitCodePtr))
-										{
-											*ExitCodePtr = -1;
-										}
-										*DoneIf = true;
-									});
-								EdWorld->GetTimerManager().SetTimer(TimerHandle, TimerDelegate, 0.5f, false);
-							}
-						}
+								if (*TriggerUndoneIf && FPlatformTime::Seconds() - ExitTime < B_UNREAL_PS_PROCESS_EXIT_MAX_DELAY_SECONDS)
+								{
+									return true;
+								}
+
+								*ExecPtr = PS_GCP_PROCESS_EXEC::ProcessExited;
+								if (!FPlatformProcess::GetProcReturnCode((FProcHandle&)ProcessHandle.ProcessHandle, ExitCodePtr))
+								{
+									*ExitCodePtr = -1;
+								}
+								*DoneIf = true;
+								return false;
+							}));
 					});
 			});
 
@@ -205,6 +282,108 @@ bool UPSGCPWidgetBlueprintLibrary::KillCloseHiddenProcess(const FProcessHandleWr
 	return false;
 }
 
+TArray<FString> UPSGCPWidgetBlueprintLibrary::ListProcessLogs()
+{
+	TArray<FString> Names;
+	PSGCPProcessLog::ListLogs(FPaths::ConvertRelativePathToFull(FString(B_UNREAL_PS_PROCESS_LOGS_FOLDER_LOCAL_RELATIVE_PATH)), Names);
+	return Names;
+}
+
+void UPSGCPWidgetBlueprintLibrary::ReadProcessLog(const FString& LogName, int32 StartLine, int32 MaxLines, int32& FirstLine, int32& TotalLineCount, TArray<FString>& Lines, FString& ErrorMessage, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo)
+{
+	bool* DoneIf = new bool(false);
+
+	int32* FirstLinePtr = &FirstLine;
+	int32* TotalLineCountPtr = &TotalLineCount;
+	TArray<FString>* LinesPtr = &Lines;
+	FString* ErrorMessagePtr = &ErrorMessage;
+	PS_GCP_SUCCESS_FAIL_OUT_EXEC* ExecPtr = &Exec;
+
+	PrepareLatentBPExecAction(DoneIf, nullptr, LatentInfo);
+
+	FString LogsFolderAbsolutePath = FPaths::ConvertRelativePathToFull(FString(B_UNREAL_PS_PROCESS_LOGS_FOLDER_LOCAL_RELATIVE_PATH));
+
+	FBLambdaRunnable::RunLambdaOnDedicatedBackgroundThread([LogsFolderAbsolutePath, LogName, StartLine, MaxLines, DoneIf, FirstLinePtr, TotalLineCountPtr, LinesPtr, ErrorMessagePtr, ExecPtr]()
+		{
+			FString TmpErrorMessage;
+			TArray<FString> TmpLines;
+			int64 TmpFirstLine = 0;
+			int64 RangeFirstLine = 0;
+			int64 RangeLineCount = 0;
+
+			PSGCPProcessLog::FPtr Log = PSGCPProcessLog::FindOrOpen(LogsFolderAbsolutePath, LogName, TmpErrorMessage);
+			bool bSucceed = Log.IsValid() && Log->ReadLines(StartLine, MaxLines, TmpFirstLine, TmpLines, TmpErrorMessage);
+			if (bSucceed)
+			{
+				Log->GetLineRange(RangeFirstLine, RangeLineCount);
+			}
+
+			FBLambdaRunnable::RunLambdaOnGameThread([bSucceed, TmpErrorMessage, TmpLines, TmpFirstLine, RangeFirstLine, RangeLineCount, DoneIf, FirstLinePtr, TotalLineCountPtr, LinesPtr, ErrorMessagePtr, ExecPtr]()
+				{
+					if (bSucceed)
+					{
+						*FirstLinePtr = (int32)TmpFirstLine;
+						*TotalLineCountPtr = (int32)(RangeFirstLine + RangeLineCount);
+						*LinesPtr = TmpLines;
+						*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Succeed;
+					}
+					else
+					{
+						*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Failed;
+						*ErrorMessagePtr = TmpErrorMessage;
+					}
+					*DoneIf = true;
+				});
+		});
+}
+
+void UPSGCPWidgetBlueprintLibrary::FilterProcessLog(const FString& LogName, const FString& Filter, int32 StartLine, int32 MaxResults, TArray<int32>& LineNumbers, TArray<FString>& Lines, int32& NextStartLine, FString& ErrorMessage, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo)
+{
+	bool* DoneIf = new bool(false);
+
+	TArray<int32>* LineNumbersPtr = &LineNumbers;
+	TArray<FString>* LinesPtr = &Lines;
+	int32* NextStartLinePtr = &NextStartLine;
+	FString* ErrorMessagePtr = &ErrorMessage;
+	PS_GCP_SUCCESS_FAIL_OUT_EXEC* ExecPtr = &Exec;
+
+	PrepareLatentBPExecAction(DoneIf, nullptr, LatentInfo);
+
+	FString LogsFolderAbsolutePath = FPaths::ConvertRelativePathToFull(FString(B_UNREAL_PS_PROCESS_LOGS_FOLDER_LOCAL_RELATIVE_PATH));
+
+	FBLambdaRunnable::RunLambdaOnDedicatedBackgroundThread([LogsFolderAbsolutePath, LogName, Filter, StartLine, MaxResults, DoneIf, LineNumbersPtr, LinesPtr, NextStartLinePtr, ErrorMessagePtr, ExecPtr]()
+		{
+			FString TmpErrorMessage;
+			TArray<int64> TmpLineNumbers;
+			TArray<FString> TmpLines;
+			int64 TmpNextLine = 0;
+
+			PSGCPProcessLog::FPtr Log = PSGCPProcessLog::FindOrOpen(LogsFolderAbsolutePath, LogName, TmpErrorMessage);
+			bool bSucceed = Log.IsValid() && Log->FilterLines(Filter, StartLine, MaxResults, TmpLineNumbers, TmpLines, TmpNextLine, TmpErrorMessage);
+
+			FBLambdaRunnable::RunLambdaOnGameThread([bSucceed, TmpErrorMessage, TmpLineNumbers, TmpLines, TmpNextLine, DoneIf, LineNumbersPtr, LinesPtr, NextStartLinePtr, ErrorMessagePtr, ExecPtr]()
+				{
+					if (bSucceed)
+					{
+						LineNumbersPtr->Reset(TmpLineNumbers.Num());
+						for (int64 LineNumber : TmpLineNumbers)
+						{
+							LineNumbersPtr->Add((int32)LineNumber);
+						}
+						*LinesPtr = TmpLines;
+						*NextStartLinePtr = (int32)TmpNextLine;
+						*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Succeed;
+					}
+					else
+					{
+						*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Failed;
+						*ErrorMessagePtr = TmpErrorMessage;
+					}
+					*DoneIf = true;
+				});
+		});
+}
+
 bool UPSGCPWidgetBlueprintLibrary::DownloadBUnrealPSPluginProcessor(const FString& GC_BucketName, FString& ProgramAbsolutePath, FString& ErrorMessage, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo)
 {
 	bool* DoneIf = new bool(false);
@@ -215,6 +394,33 @@ bool UPSGCPWidgetBlueprintLibrary::DownloadBUnrealPSPluginProcessor(const FStrin
 
 	PrepareLatentBPExecAction(DoneIf, nullptr, LatentInfo);
 
+	PSGCPProcessorUpdater::TryPatchUpdate(
+		FString(B_UNREAL_PS_PLUGIN_PROCESSOR_MANIFEST_URL).Replace(TEXT("{{BUCKET_NAME}}"), *GC_BucketName, ESearchCase::CaseSensitive),
+		FString(B_UNREAL_PS_PLUGIN_PROCESSOR_RELEASES_URL).Replace(TEXT("{{BUCKET_NAME}}"), *GC_BucketName, ESearchCase::CaseSensitive),
+		FPaths::ConvertRelativePathToFull(FString(B_UNREAL_PS_PLUGIN_PROCESSOR_EXTRACT_FOLDER_LOCAL_RELATIVE_PATH)),
+		FPaths::ConvertRelativePathToFull(FString(B_UNREAL_PS_PLUGIN_PROCESSOR_STAGING_FOLDER_LOCAL_RELATIVE_PATH)),
+		[GC_BucketName, DoneIf, ProgramAbsolutePathPtr, ErrorMessagePtr, ExecPtr](bool bSucceed, const FString& PatchErrorMessage)
+		{
+			FString ExeRelativePath = FString(B_UNREAL_PS_PLUGIN_PROCESSOR_EXE_LOCAL_RELATIVE_PATH_UPON_EXTRACT);
+
+			if (bSucceed && IFileManager::Get().FileExists(*ExeRelativePath))
+			{
+				*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Succeed;
+				*ProgramAbsolutePathPtr = FPaths::ConvertRelativePathToFull(ExeRelativePath);
+				*DoneIf = true;
+				return;
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("UPSGCPWidgetBlueprintLibrary::DownloadBUnrealPSPluginProcessor: Patch update is not possible (%s), downloading the full release."), *PatchErrorMessage);
+			DownloadFullBUnrealPSPluginProcessor(GC_BucketName, DoneIf, ProgramAbsolutePathPtr, ErrorMessagePtr, ExecPtr);
+		});
+
+	//DoneIf is only set by now if neither the patch update nor the full download could start a request.
+	return !(*DoneIf);
+}
+
+bool UPSGCPWidgetBlueprintLibrary::DownloadFullBUnrealPSPluginProcessor(const FString& GC_BucketName, bool* DoneIf, FString* ProgramAbsolutePathPtr, FString* ErrorMessagePtr, PS_GCP_SUCCESS_FAIL_OUT_EXEC* ExecPtr)
+{
 	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->SetVerb("GET");
 	HttpRequest->SetURL(FString(B_UNREAL_PS_PLUGIN_PROCESSOR_URL).Replace(TEXT("{{BUCKET_NAME}}"), *FString::Printf(TEXT("%s"), *GC_BucketName), ESearchCase::CaseSensitive));
@@ -224,6 +430,9 @@ bool UPSGCPWidgetBlueprintLibrary::DownloadBUnrealPSPluginProcessor(const FStrin
 			if (!bConnectedSuccessfully)
 			{
 				UE_LOG(LogTemp, Error, TEXT("UPSGCPWidgetBlueprintLibrary::DownloadBUnrealPSPluginProcessor::OnProcessRequestComplete: Callback is invalid."));
+				*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Failed;
+				*ErrorMessagePtr = "Request has failed to connect.";
+				*DoneIf = true;
 				return;
 			}
 
@@ -295,25 +504,55 @@ bool UPSGCPWidgetBlueprintLibrary::DownloadBUnrealPSPluginProcessor(const FStrin
 			*ProgramAbsolutePathPtr = ExeAbsolutePath;
 			*DoneIf = true;
 		});
-	return HttpRequest->ProcessRequest();
+
+	if (!HttpRequest->ProcessRequest())
+	{
+		*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Failed;
+		*ErrorMessagePtr = "Failed to start the download request.";
+		*DoneIf = true;
+		return false;
+	}
+	return true;
 }
 
-void UPSGCPWidgetBlueprintLibrary::ZipPackagedApplicationFolder(const FString& PackagedApplicationFolderAbsolutePath, FString& CompressedZipAbsolutePath, FString& ErrorMessage, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo)
+void UPSGCPWidgetBlueprintLibrary::ZipPackagedApplicationFolder(const FString& PackagedApplicationFolderAbsolutePath, FString& CompressedZipAbsolutePath, FString& ErrorMessage, bool& bCancelled, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo)
 {
+	if (bZipPackagedApplicationFolderRunning.AtomicSet(true))
+	{
+		//Like engine latent nodes, a node that is already running ignores being triggered again; its job reports through the existing action.
+		if (HasLatentBPExecAction(LatentInfo))
+		{
+			return;
+		}
+
+		bool* DoneIf = new bool(false);
+		PrepareLatentBPExecAction(DoneIf, nullptr, LatentInfo);
+
+		bCancelled = false;
+		Exec = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Failed;
+		ErrorMessage = "Another compression job is already running.";
+		*DoneIf = true;
+		return;
+	}
+	bZipPackagedApplicationFolderCancelRequested = false;
+
 	bool* DoneIf = new bool(false);
 
 	FString* ErrorMessagePtr = &ErrorMessage;
 	FString* CompressedZipAbsolutePathPtr = &CompressedZipAbsolutePath;
+	bool* bCancelledPtr = &bCancelled;
 	PS_GCP_SUCCESS_FAIL_OUT_EXEC* ExecPtr = &Exec;
 
 	PrepareLatentBPExecAction(DoneIf, nullptr, LatentInfo);
 
-	FBLambdaRunnable::RunLambdaOnDedicatedBackgroundThread([PackagedApplicationFolderAbsolutePath, DoneIf, CompressedZipAbsolutePathPtr, ErrorMessagePtr, ExecPtr]()
+	FBLambdaRunnable::RunLambdaOnDedicatedBackgroundThread([PackagedApplicationFolderAbsolutePath, DoneIf, CompressedZipAbsolutePathPtr, ErrorMessagePtr, bCancelledPtr, ExecPtr]()
 		{
 			if (!IFileManager::Get().DirectoryExists(*PackagedApplicationFolderAbsolutePath))
 			{
-				FBLambdaRunnable::RunLambdaOnGameThread([PackagedApplicationFolderAbsolutePath, DoneIf, ErrorMessagePtr, ExecPtr]()
+				bZipPackagedApplicationFolderRunning = false;
+				FBLambdaRunnable::RunLambdaOnGameThread([PackagedApplicationFolderAbsolutePath, DoneIf, ErrorMessagePtr, bCancelledPtr, ExecPtr]()
 					{
+						*bCancelledPtr = false;
 						*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Failed;
 						*ErrorMessagePtr = FString::Printf(TEXT("Directory does not exist at %s"), *PackagedApplicationFolderAbsolutePath);
 						*DoneIf = true;
@@ -321,30 +560,63 @@ void UPSGCPWidgetBlueprintLibrary::ZipPackagedApplicationFolder(const FString& P
 				return;
 			}
 
-			FString LocalZipRelativePath = FString(B_UNREAL_PACKAGED_PS_APPLICATION_ZIP_LOCAL_RELATIVE_PATH);
-			FString LocalZipAbsolutePath = FPaths::ConvertRelativePathToFull(LocalZipRelativePath);
-
-			if (IFileManager::Get().FileExists(*LocalZipRelativePath))
-				IFileManager::Get().Delete(*LocalZipRelativePath);
+			FString LocalZipAbsolutePath = FPaths::ConvertRelativePathToFull(FString(B_UNREAL_PACKAGED_PS_APPLICATION_ZIP_LOCAL_RELATIVE_PATH));
+			FString JournalAbsolutePath = FPaths::ConvertRelativePathToFull(FString(B_UNREAL_PACKAGED_PS_APPLICATION_ZIP_JOURNAL_LOCAL_RELATIVE_PATH));
 
 			FString TmpErrorMessage;
-			
-			if (!BZipFile::CompressAll(PackagedApplicationFolderAbsolutePath, LocalZipAbsolutePath, TmpErrorMessage))
-			{
-				if (IFileManager::Get().FileExists(*LocalZipRelativePath))
-					IFileManager::Get().Delete(*LocalZipRelativePath);
-				*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Failed;
-				*ErrorMessagePtr = TmpErrorMessage;
-				*DoneIf = true;
-				return;
-			}
+			bool bCancelled = false;
 
-			*CompressedZipAbsolutePathPtr = LocalZipAbsolutePath;
-			*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Succeed;
-			*DoneIf = true;
+			bool bSucceed = PSGCPResumableZip::CompressAll(
+				PackagedApplicationFolderAbsolutePath,
+				LocalZipAbsolutePath,
+				JournalAbsolutePath,
+				bZipPackagedApplicationFolderCancelRequested,
+				bCancelled,
+				TmpErrorMessage);
+
+			bZipPackagedApplicationFolderRunning = false;
+
+			FBLambdaRunnable::RunLambdaOnGameThread([bSucceed, bCancelled, LocalZipAbsolutePath, TmpErrorMessage, DoneIf, CompressedZipAbsolutePathPtr, ErrorMessagePtr, bCancelledPtr, ExecPtr]()
+				{
+					*bCancelledPtr = bCancelled;
+					if (bSucceed)
+					{
+						*CompressedZipAbsolutePathPtr = LocalZipAbsolutePath;
+						*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Succeed;
+					}
+					else
+					{
+						*ExecPtr = PS_GCP_SUCCESS_FAIL_OUT_EXEC::Failed;
+						*ErrorMessagePtr = TmpErrorMessage;
+					}
+					*DoneIf = true;
+				});
 		});
 }
 
+void UPSGCPWidgetBlueprintLibrary::CancelZipPackagedApplicationFolder()
+{
+	if (bZipPackagedApplicationFolderRunning)
+	{
+		bZipPackagedApplicationFolderCancelRequested = true;
+	}
+}
+
+FThreadSafeBool UPSGCPWidgetBlueprintLibrary::bZipPackagedApplicationFolderRunning = false;
+FThreadSafeBool UPSGCPWidgetBlueprintLibrary::bZipPackagedApplicationFolderCancelRequested = false;
+
+bool UPSGCPWidgetBlueprintLibrary::HasLatentBPExecAction(const FLatentActionInfo& LatentInfo)
+{
+	if (UWorld* World = GEditor->GetEditorWorldContext().World())
+	{
+		if (World->IsValidLowLevel() && !World->IsPendingKillOrUnreachable())
+		{
+			return World->GetLatentActionManager().FindExistingAction<FPSGCPLatentAction_Internal>(LatentInfo.CallbackTarget, LatentInfo.UUID) != nullptr;
+		}
+	}
+	return false;
+}
+
 void UPSGCPWidgetBlueprintLibrary::PrepareLatentBPExecAction(bool* InDoneIf, bool* InTriggerUndoneIf, FLatentActionInfo& LatentInfo)
 {
 	if (UWorld* World = GEditor->GetEditorWorldContext().World())
@@ -0,0 +1,81 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "JsonUtilities.h"
+
+//Benchmarks are run from the commandline with e.g.
+//UE4Editor-Cmd.exe Project.uproject -nullrhi -unattended -ExecCmds="Automation RunTests BPixelStreamingGCP; Quit"
+//-PSGCPBenchmarkScale=N multiplies the synthetic data sizes, -PSGCPBenchmarkOutput=Dir overrides where the JSON results go.
+namespace PSGCPBenchmarkUtilities
+{
+	inline int32 GetScale()
+	{
+		int32 Scale = 1;
+		FParse::Value(FCommandLine::Get(), TEXT("PSGCPBenchmarkScale="), Scale);
+		return FMath::Max(Scale, 1);
+	}
+
+	inline FString GetWorkingDirectory(const FString& Name)
+	{
+		return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("PSGCPBenchmarks") / Name);
+	}
+
+	inline FString WriteResults(const FString& BenchmarkName, const TArray<TSharedPtr<FJsonValue>>& Results)
+	{
+		FString OutputDirectory;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("PSGCPBenchmarkOutput="), OutputDirectory))
+		{
+			OutputDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectPluginsDir() + "BPixelStreamingGCP/Saved/Benchmarks");
+		}
+
+		TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+		JsonObject->SetStringField("benchmark", BenchmarkName);
+		JsonObject->SetStringField("timestamp", FDateTime::UtcNow().ToIso8601());
+		JsonObject->SetStringField("platform", FPlatformProperties::IniPlatformName());
+		JsonObject->SetStringField("cpu", FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+		JsonObject->SetNumberField("cores", FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+		JsonObject->SetNumberField("scale", GetScale());
+		JsonObject->SetArrayField("results", Results);
+
+		FString OutputString;
+		auto Writer = TJsonWriterFactory<>::Create(&OutputString);
+		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+
+		const FString OutputPath = OutputDirectory / FString::Printf(TEXT("%s-%s.json"), *BenchmarkName, *FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S")));
+		FFileHelper::SaveStringToFile(OutputString, *OutputPath);
+		return OutputPath;
+	}
+
+	//Runs the work on its own thread while the calling thread samples the process memory.
+	template <typename FuncType>
+	double MeasureWork(FuncType&& Work, uint64& OutPeakUsedPhysicalDelta)
+	{
+		const uint64 BaselineUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+		uint64 PeakUsedPhysical = BaselineUsedPhysical;
+
+		const double StartTime = FPlatformTime::Seconds();
+		TFuture<void> Future = Async(EAsyncExecution::Thread, Forward<FuncType>(Work));
+		while (!Future.IsReady())
+		{
+			PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+			FPlatformProcess::Sleep(0.01f);
+		}
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		OutPeakUsedPhysicalDelta = PeakUsedPhysical - BaselineUsedPhysical;
+		return Elapsed;
+	}
+}
+
+#endif
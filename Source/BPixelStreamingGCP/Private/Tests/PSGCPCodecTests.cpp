@@ -0,0 +1,263 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "PSGCPCodec.h"
+#include "PSGCPWidgetBlueprintLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const EPSGCPCodecKernel CodecTestKernels[] = { EPSGCPCodecKernel::Scalar, EPSGCPCodecKernel::SSSE3, EPSGCPCodecKernel::AVX2 };
+
+	const TCHAR* KernelName(EPSGCPCodecKernel Kernel)
+	{
+		switch (Kernel)
+		{
+		case EPSGCPCodecKernel::AVX2: return TEXT("AVX2");
+		case EPSGCPCodecKernel::SSSE3: return TEXT("SSSE3");
+		default: return TEXT("Scalar");
+		}
+	}
+
+	//TArray has no overrun checks of its own; output buffers get a guard band after the documented length instead.
+	const int32 GuardSize = 64;
+	const uint8 GuardByte = 0xA5;
+
+	template <typename T>
+	T* GuardedBuffer(TArray<T>& Buffer, int64 Size)
+	{
+		Buffer.SetNumUninitialized(Size + GuardSize);
+		FMemory::Memset(Buffer.GetData() + Size, GuardByte, GuardSize * sizeof(T));
+		return Buffer.GetData();
+	}
+
+	template <typename T>
+	bool IsGuardIntact(const TArray<T>& Buffer, int64 Size)
+	{
+		const uint8* Guard = (const uint8*)(Buffer.GetData() + Size);
+		for (int32 i = 0; i < GuardSize * (int32)sizeof(T); i++)
+		{
+			if (Guard[i] != GuardByte) return false;
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPCodecVectorsTest, "BPixelStreamingGCP.Codec.Vectors", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPSGCPCodecVectorsTest::RunTest(const FString& Parameters)
+{
+	//RFC 4648 section 10.
+	const ANSICHAR* Inputs[] = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+	const ANSICHAR* Base64Outputs[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy" };
+	const ANSICHAR* HexOutputs[] = { "", "66", "666f", "666f6f", "666f6f62", "666f6f6261", "666f6f626172" };
+
+	for (int32 i = 0; i < UE_ARRAY_COUNT(Inputs); i++)
+	{
+		const int32 Length = FCStringAnsi::Strlen(Inputs[i]);
+
+		ANSICHAR Encoded[16] = {};
+		PSGCPCodec::Base64Encode((const uint8*)Inputs[i], Length, Encoded);
+		TestEqual(FString::Printf(TEXT("Base64 of \"%s\""), ANSI_TO_TCHAR(Inputs[i])), FString(Encoded), FString(Base64Outputs[i]));
+
+		FMemory::Memzero(Encoded);
+		PSGCPCodec::HexEncode((const uint8*)Inputs[i], Length, Encoded);
+		TestEqual(FString::Printf(TEXT("Hex of \"%s\""), ANSI_TO_TCHAR(Inputs[i])), FString(Encoded), FString(HexOutputs[i]));
+	}
+
+	uint8 Decoded[16];
+	int64 Written = 0;
+	TestFalse(TEXT("Padding in the middle is rejected"), PSGCPCodec::Base64Decode("Zg==Zg==", 8, Decoded, Written));
+	TestFalse(TEXT("A single trailing character is rejected"), PSGCPCodec::Base64Decode("Zm9vY", 5, Decoded, Written));
+	TestFalse(TEXT("Whitespace is rejected"), PSGCPCodec::Base64Decode("Zm9v\nYmFy", 9, Decoded, Written));
+	TestTrue(TEXT("Unpadded base64 is accepted"), PSGCPCodec::Base64Decode("Zm9vYg", 6, Decoded, Written) && Written == 4);
+	TestFalse(TEXT("Odd length hex is rejected"), PSGCPCodec::HexDecode("666", 3, Decoded, Written));
+	TestTrue(TEXT("Upper case hex is accepted"), PSGCPCodec::HexDecode("666F6F", 6, Decoded, Written) && Written == 3);
+
+	TestEqual(TEXT("HexEncode encodes UTF-8 bytes"), UPSGCPWidgetBlueprintLibrary::HexEncode(TEXT("a\u00E7")), FString(TEXT("61C3A7")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPCodecRoundTripTest, "BPixelStreamingGCP.Codec.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPSGCPCodecRoundTripTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Random(28);
+
+	for (EPSGCPCodecKernel Kernel : CodecTestKernels)
+	{
+		if (!PSGCPCodec::IsKernelSupported(Kernel))
+		{
+			AddInfo(FString::Printf(TEXT("%s is not supported on this CPU; it falls back to a lower kernel."), KernelName(Kernel)));
+		}
+
+		for (int32 Length = 0; Length < 300; Length++)
+		{
+			TArray<uint8> Input;
+			Input.SetNumUninitialized(Length);
+			for (uint8& Byte : Input) Byte = (uint8)Random.RandRange(0, 255);
+
+			//Buffers are sized to the documented lengths plus a guard band, so a kernel writing past them is caught.
+			const int64 HexLength = PSGCPCodec::HexEncodedLength(Length);
+			TArray<ANSICHAR> Hex;
+			PSGCPCodec::HexEncode(Input.GetData(), Length, GuardedBuffer(Hex, HexLength), Length % 2 == 0, Kernel);
+			TestTrue(TEXT("Hex encoding stays in bounds"), IsGuardIntact(Hex, HexLength));
+			Hex.SetNum(HexLength);
+
+			const int64 HexDecodedLength = PSGCPCodec::HexMaxDecodedLength(Hex.Num());
+			TArray<uint8> HexDecoded;
+			int64 Written = 0;
+			if (!PSGCPCodec::HexDecode(Hex.GetData(), Hex.Num(), GuardedBuffer(HexDecoded, HexDecodedLength), Written, Kernel)
+				|| !IsGuardIntact(HexDecoded, HexDecodedLength)
+				|| Written != Length
+				|| FMemory::Memcmp(HexDecoded.GetData(), Input.GetData(), Length) != 0)
+			{
+				AddError(FString::Printf(TEXT("%s hex round trip fails for %d bytes"), KernelName(Kernel), Length));
+			}
+
+			const int64 Base64Length = PSGCPCodec::Base64EncodedLength(Length);
+			TArray<ANSICHAR> Base64;
+			TestEqual(TEXT("Base64 length"), PSGCPCodec::Base64Encode(Input.GetData(), Length, GuardedBuffer(Base64, Base64Length), Kernel), Base64Length);
+			TestTrue(TEXT("Base64 encoding stays in bounds"), IsGuardIntact(Base64, Base64Length));
+			Base64.SetNum(Base64Length);
+
+			const int64 Base64DecodedLength = PSGCPCodec::Base64MaxDecodedLength(Base64.Num());
+			TArray<uint8> Base64Decoded;
+			if (!PSGCPCodec::Base64Decode(Base64.GetData(), Base64.Num(), GuardedBuffer(Base64Decoded, Base64DecodedLength), Written, Kernel)
+				|| !IsGuardIntact(Base64Decoded, Base64DecodedLength)
+				|| Written != Length)
+			{
+				AddError(FString::Printf(TEXT("%s base64 round trip fails for %d bytes"), KernelName(Kernel), Length));
+			}
+			else
+			{
+				Base64Decoded.SetNum(Length);
+				TestTrue(FString::Printf(TEXT("%s base64 round trip matches for %d bytes"), KernelName(Kernel), Length), Base64Decoded == Input);
+			}
+
+			if (Length > 4)
+			{
+				Base64Decoded.SetNumUninitialized(Base64DecodedLength);
+				HexDecoded.SetNumUninitialized(HexDecodedLength);
+				Base64[Random.RandRange(0, Base64.Num() - 5)] = '*';
+				TestFalse(TEXT("Invalid base64 is rejected"), PSGCPCodec::Base64Decode(Base64.GetData(), Base64.Num(), Base64Decoded.GetData(), Written, Kernel));
+				Hex[Random.RandRange(0, Hex.Num() - 1)] = 'g';
+				TestFalse(TEXT("Invalid hex is rejected"), PSGCPCodec::HexDecode(Hex.GetData(), Hex.Num(), HexDecoded.GetData(), Written, Kernel));
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPCodecStreamingTest, "BPixelStreamingGCP.Codec.Streaming", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPSGCPCodecStreamingTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Random(29);
+
+	TArray<uint8> Input;
+	Input.SetNumUninitialized(64 * 1024 + 7);
+	for (uint8& Byte : Input) Byte = (uint8)Random.RandRange(0, 255);
+
+	for (EPSGCPCodecKernel Kernel : CodecTestKernels)
+	{
+		TArray<ANSICHAR> Expected;
+		Expected.SetNumUninitialized(PSGCPCodec::Base64EncodedLength(Input.Num()));
+		PSGCPCodec::Base64Encode(Input.GetData(), Input.Num(), Expected.GetData(), Kernel);
+
+		//Every chunk goes into its own buffer of MaxUpdateLength(ChunkSize) plus a guard band, so an update writing more than it documents is caught.
+		bool bInBounds = true;
+		auto CheckChunk = [&](const auto& ChunkBuffer, int64 MaxLength, int64 Written)
+		{
+			bInBounds &= Written <= MaxLength && IsGuardIntact(ChunkBuffer, MaxLength);
+		};
+
+		PSGCPCodec::FBase64Encoder Encoder(Kernel);
+		TArray<ANSICHAR> Encoded;
+		TArray<ANSICHAR> EncodedChunk;
+		for (int64 Offset = 0; Offset < Input.Num();)
+		{
+			const int64 ChunkSize = FMath::Min<int64>(Random.RandRange(0, 97), Input.Num() - Offset);
+			const int64 MaxLength = Encoder.MaxUpdateLength(ChunkSize);
+			const int64 Written = Encoder.Update(Input.GetData() + Offset, ChunkSize, GuardedBuffer(EncodedChunk, MaxLength));
+			CheckChunk(EncodedChunk, MaxLength, Written);
+			Encoded.Append(EncodedChunk.GetData(), Written);
+			Offset += ChunkSize;
+		}
+		const int64 FinishWritten = Encoder.Finish(GuardedBuffer(EncodedChunk, 4));
+		CheckChunk(EncodedChunk, 4, FinishWritten);
+		Encoded.Append(EncodedChunk.GetData(), FinishWritten);
+		TestTrue(FString::Printf(TEXT("%s chunked base64 encoding matches"), KernelName(Kernel)), Encoded == Expected);
+
+		//Chunk sizes down to a single character, so padding arrives on its own.
+		PSGCPCodec::FBase64Decoder Decoder(Kernel);
+		TArray<uint8> Decoded;
+		TArray<uint8> DecodedChunk;
+		bool bSucceed = true;
+		for (int64 Offset = 0; Offset < Expected.Num();)
+		{
+			const int64 ChunkSize = FMath::Min<int64>(Random.RandRange(0, 3) == 0 ? Random.RandRange(0, 1) : Random.RandRange(0, 131), Expected.Num() - Offset);
+			const int64 MaxLength = Decoder.MaxUpdateLength(ChunkSize);
+			int64 Written = 0;
+			bSucceed &= Decoder.Update(Expected.GetData() + Offset, ChunkSize, GuardedBuffer(DecodedChunk, MaxLength), Written);
+			CheckChunk(DecodedChunk, MaxLength, Written);
+			Decoded.Append(DecodedChunk.GetData(), Written);
+			Offset += ChunkSize;
+		}
+		int64 Written = 0;
+		bSucceed &= Decoder.Finish(GuardedBuffer(DecodedChunk, 2), Written);
+		CheckChunk(DecodedChunk, 2, Written);
+		Decoded.Append(DecodedChunk.GetData(), Written);
+		TestTrue(FString::Printf(TEXT("%s chunked base64 decoding matches"), KernelName(Kernel)), bSucceed && Decoded == Input);
+
+		//Padding split from its quantum, e.g. "Zg=" followed by "=".
+		const ANSICHAR* PaddedInputs[] = { "Zg==", "Zm8=" };
+		const int64 PaddedDecodedLengths[] = { 1, 2 };
+		for (int32 PaddedIndex = 0; PaddedIndex < UE_ARRAY_COUNT(PaddedInputs); PaddedIndex++)
+		{
+			const ANSICHAR* Padded = PaddedInputs[PaddedIndex];
+
+			PSGCPCodec::FBase64Decoder PaddingDecoder(Kernel);
+			bool bPaddingSucceed = true;
+			int64 PaddingDecodedLength = 0;
+			for (int32 i = 0; Padded[i] != '\0'; i++)
+			{
+				const int64 MaxLength = PaddingDecoder.MaxUpdateLength(1);
+				bPaddingSucceed &= PaddingDecoder.Update(Padded + i, 1, GuardedBuffer(DecodedChunk, MaxLength), Written);
+				CheckChunk(DecodedChunk, MaxLength, Written);
+				PaddingDecodedLength += Written;
+			}
+			bPaddingSucceed &= PaddingDecoder.Finish(GuardedBuffer(DecodedChunk, 2), Written);
+			CheckChunk(DecodedChunk, 2, Written);
+			PaddingDecodedLength += Written;
+
+			TestTrue(FString::Printf(TEXT("%s decodes %s one character at a time"), KernelName(Kernel), ANSI_TO_TCHAR(Padded)),
+				bPaddingSucceed && PaddingDecodedLength == PaddedDecodedLengths[PaddedIndex]);
+		}
+
+		TArray<ANSICHAR> Hex;
+		Hex.SetNumUninitialized(PSGCPCodec::HexEncodedLength(Input.Num()));
+		PSGCPCodec::HexEncode(Input.GetData(), Input.Num(), Hex.GetData(), false, Kernel);
+
+		PSGCPCodec::FHexDecoder HexDecoder(Kernel);
+		Decoded.Reset();
+		bSucceed = true;
+		for (int64 Offset = 0; Offset < Hex.Num();)
+		{
+			const int64 ChunkSize = FMath::Min<int64>(Random.RandRange(0, 131), Hex.Num() - Offset);
+			const int64 MaxLength = HexDecoder.MaxUpdateLength(ChunkSize);
+			bSucceed &= HexDecoder.Update(Hex.GetData() + Offset, ChunkSize, GuardedBuffer(DecodedChunk, MaxLength), Written);
+			CheckChunk(DecodedChunk, MaxLength, Written);
+			Decoded.Append(DecodedChunk.GetData(), Written);
+			Offset += ChunkSize;
+		}
+		TestTrue(FString::Printf(TEXT("%s chunked hex decoding matches"), KernelName(Kernel)), bSucceed && HexDecoder.Finish() && Decoded == Input);
+		TestTrue(FString::Printf(TEXT("%s streaming updates stay within MaxUpdateLength"), KernelName(Kernel)), bInBounds);
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,283 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "PSGCPBenchmarkUtilities.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "BZipFile.h"
+#include "PSGCPResumableZip.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	struct FPSGCPBenchmarkTreeShape
+	{
+		const TCHAR* Name;
+		int32 SmallFileCount;
+		int64 SmallFileSize;
+		int32 LargeFileCount;
+		int64 LargeFileSize;
+	};
+
+	const FPSGCPBenchmarkTreeShape BenchmarkTreeShapes[] =
+	{
+		{ TEXT("ManySmallFiles"), 4000, 8 * 1024, 0, 0 },
+		{ TEXT("FewLargePaks"), 0, 0, 2, 256 * 1024 * 1024 },
+		{ TEXT("Mixed"), 1000, 16 * 1024, 2, 96 * 1024 * 1024 }
+	};
+
+	//Half random, half repeated text; roughly as compressible as a cooked build.
+	bool GenerateFile(const FString& Path, int64 Size, const TArray<uint8>& Pattern, int32 Seed)
+	{
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path));
+		if (!Handle.IsValid()) return false;
+
+		TArray<uint8> Chunk = Pattern;
+		int64 Remaining = Size;
+		while (Remaining > 0)
+		{
+			Chunk[0] ^= (uint8)Seed;
+			Chunk[1] ^= (uint8)(Remaining >> 20);
+
+			const int64 WriteSize = FMath::Min<int64>(Remaining, Chunk.Num());
+			if (!Handle->Write(Chunk.GetData(), WriteSize)) return false;
+			Remaining -= WriteSize;
+		}
+		return true;
+	}
+
+	int64 GenerateTree(const FString& Root, const FPSGCPBenchmarkTreeShape& Shape, int32 Scale)
+	{
+		TArray<uint8> Pattern;
+		Pattern.SetNumUninitialized(1024 * 1024);
+
+		FRandomStream Random(Shape.SmallFileCount ^ Shape.LargeFileCount);
+		const ANSICHAR Text[] = "PixelStreamingGCP packaged application content ";
+		for (int32 i = 0; i < Pattern.Num(); i++)
+		{
+			Pattern[i] = (i / 4096) % 2 == 0 ? (uint8)Random.RandRange(0, 255) : (uint8)Text[i % (sizeof(Text) - 1)];
+		}
+
+		IFileManager::Get().MakeDirectory(*Root, true);
+
+		int64 TotalSize = 0;
+		for (int32 i = 0; i < Shape.SmallFileCount * Scale; i++)
+		{
+			const FString Path = Root / FString::Printf(TEXT("Content/Dir%03d/File%05d.uasset"), i % 64, i);
+			IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+			if (!GenerateFile(Path, Shape.SmallFileSize, Pattern, i)) return -1;
+			TotalSize += Shape.SmallFileSize;
+		}
+		for (int32 i = 0; i < Shape.LargeFileCount; i++)
+		{
+			const FString Path = Root / FString::Printf(TEXT("Content/Paks/Game-WindowsNoEditor_%d.pak"), i);
+			IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+			if (!GenerateFile(Path, Shape.LargeFileSize * Scale, Pattern, i)) return -1;
+			TotalSize += Shape.LargeFileSize * Scale;
+		}
+		return TotalSize;
+	}
+
+	bool CompareTrees(const FString& Expected, const FString& Actual, FString& ErrorMessage)
+	{
+		TArray<FString> ExpectedFiles;
+		TArray<FString> ActualFiles;
+		IFileManager::Get().FindFilesRecursive(ExpectedFiles, *Expected, TEXT("*"), true, false);
+		IFileManager::Get().FindFilesRecursive(ActualFiles, *Actual, TEXT("*"), true, false);
+
+		if (ExpectedFiles.Num() != ActualFiles.Num())
+		{
+			ErrorMessage = FString::Printf(TEXT("Expected %d files, found %d."), ExpectedFiles.Num(), ActualFiles.Num());
+			return false;
+		}
+
+		for (const FString& ExpectedFile : ExpectedFiles)
+		{
+			FString RelativePath = ExpectedFile;
+			RelativePath.RemoveFromStart(Expected);
+			const FString ActualFile = Actual + RelativePath;
+
+			TArray<uint8> ExpectedContent;
+			TArray<uint8> ActualContent;
+			if (!FFileHelper::LoadFileToArray(ExpectedContent, *ExpectedFile)
+				|| !FFileHelper::LoadFileToArray(ActualContent, *ActualFile)
+				|| ExpectedContent != ActualContent)
+			{
+				ErrorMessage = FString::Printf(TEXT("%s does not match."), *RelativePath);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPResumableZipTest, "BPixelStreamingGCP.Packaging.ResumableZip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPSGCPResumableZipTest::RunTest(const FString& Parameters)
+{
+	const FString WorkingDirectory = PSGCPBenchmarkUtilities::GetWorkingDirectory(TEXT("ResumableZip"));
+	const FString SourceDirectory = WorkingDirectory / TEXT("Source");
+	const FString ExtractDirectory = WorkingDirectory / TEXT("Extract");
+	const FString ZipPath = WorkingDirectory / TEXT("Packaged.zip");
+	const FString JournalPath = ZipPath + TEXT(".journal");
+
+	IFileManager::Get().DeleteDirectory(*WorkingDirectory, false, true);
+
+	const FPSGCPBenchmarkTreeShape Shape = { TEXT("ResumableZip"), 200, 4 * 1024, 1, 8 * 1024 * 1024 };
+	if (!TestTrue(TEXT("Source tree is generated"), GenerateTree(SourceDirectory, Shape, 1) > 0)) return false;
+
+	FThreadSafeBool bCancelRequested(true);
+	bool bCancelled = false;
+	FString ErrorMessage;
+
+	TestFalse(TEXT("Cancelled job fails"), PSGCPResumableZip::CompressAll(SourceDirectory, ZipPath, JournalPath, bCancelRequested, bCancelled, ErrorMessage));
+	TestTrue(TEXT("Cancelled job reports cancellation"), bCancelled);
+
+	bCancelRequested = false;
+	if (!TestTrue(TEXT("Full job succeeds"), PSGCPResumableZip::CompressAll(SourceDirectory, ZipPath, JournalPath, bCancelRequested, bCancelled, ErrorMessage)))
+	{
+		AddError(ErrorMessage);
+		return false;
+	}
+
+	//Simulates an interruption: the journal loses its completion marker and the later half of the entries, and ends with a torn line.
+	TArray<FString> JournalLines;
+	FFileHelper::LoadFileToStringArray(JournalLines, *JournalPath);
+	JournalLines.SetNum(1 + (JournalLines.Num() - 2) / 2);
+	const TArray<FString> KeptJournalLines = JournalLines;
+	JournalLines.Add(TEXT("E\t1"));
+	FFileHelper::SaveStringArrayToFile(JournalLines, *JournalPath);
+
+	TArray<FString> Fields;
+	KeptJournalLines.Last().ParseIntoArray(Fields, TEXT("\t"), false);
+	const int64 KeptEndOffset = Fields.Num() == 9 ? FCString::Strtoi64(*Fields[6], nullptr, 10) : 0;
+	if (!TestTrue(TEXT("Journal keeps entries"), KeptEndOffset > 0)) return false;
+
+	//Compression is deterministic, so a restart would reproduce the same bytes; a marked byte in the kept part tells them apart.
+	TArray<uint8> ZipContent;
+	FFileHelper::LoadFileToArray(ZipContent, *ZipPath);
+	const int64 MarkerOffset = KeptEndOffset / 2;
+	ZipContent[MarkerOffset] ^= 0xFF;
+	FFileHelper::SaveArrayToFile(ZipContent, *ZipPath);
+	ZipContent.SetNum(KeptEndOffset);
+
+	if (!TestTrue(TEXT("Resumed job succeeds"), PSGCPResumableZip::CompressAll(SourceDirectory, ZipPath, JournalPath, bCancelRequested, bCancelled, ErrorMessage)))
+	{
+		AddError(ErrorMessage);
+		return false;
+	}
+
+	TArray<FString> ResumedJournalLines;
+	FFileHelper::LoadFileToStringArray(ResumedJournalLines, *JournalPath);
+	TArray<FString> ResumedJournalPrefix = ResumedJournalLines;
+	ResumedJournalPrefix.SetNum(FMath::Min(ResumedJournalPrefix.Num(), KeptJournalLines.Num()));
+	TestTrue(TEXT("Kept journal entries survive the resume"), ResumedJournalPrefix == KeptJournalLines);
+	TestTrue(TEXT("Resumed journal is completed past the torn line"), ResumedJournalLines.Num() > KeptJournalLines.Num() && ResumedJournalLines.Last().StartsWith(TEXT("C\t")));
+
+	TArray<uint8> ResumedZipContent;
+	FFileHelper::LoadFileToArray(ResumedZipContent, *ZipPath);
+	const bool bZipPrefixKept = ResumedZipContent.Num() > KeptEndOffset && FMemory::Memcmp(ResumedZipContent.GetData(), ZipContent.GetData(), KeptEndOffset) == 0;
+	TestTrue(TEXT("Zip is resumed after the last kept entry instead of restarted"), bZipPrefixKept);
+
+	//A completed job must not touch either file: a trailing journal line after the completion marker is ignored on load
+	//and would disappear on a rewrite, as would the marked zip byte.
+	FFileHelper::SaveStringToFile(TEXT("# untouched\n"), *JournalPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+	FString CompletedJournal;
+	FFileHelper::LoadFileToString(CompletedJournal, *JournalPath);
+
+	TestTrue(TEXT("Completed job is not redone"), PSGCPResumableZip::CompressAll(SourceDirectory, ZipPath, JournalPath, bCancelRequested, bCancelled, ErrorMessage));
+
+	FString JournalAfterCompleted;
+	FFileHelper::LoadFileToString(JournalAfterCompleted, *JournalPath);
+	TestTrue(TEXT("Completed journal is not rewritten"), JournalAfterCompleted == CompletedJournal);
+
+	TArray<uint8> ZipAfterCompleted;
+	FFileHelper::LoadFileToArray(ZipAfterCompleted, *ZipPath);
+	TestTrue(TEXT("Completed zip is not rewritten"), ZipAfterCompleted == ResumedZipContent);
+
+	//Restores the marked byte so the archive passes its CRC checks.
+	ZipAfterCompleted[MarkerOffset] ^= 0xFF;
+	FFileHelper::SaveArrayToFile(ZipAfterCompleted, *ZipPath);
+
+	if (TestTrue(TEXT("Zip is extracted"), BZipFile::ExtractAll(ZipPath, ExtractDirectory, ErrorMessage))
+		&& !CompareTrees(SourceDirectory, ExtractDirectory, ErrorMessage))
+	{
+		AddError(ErrorMessage);
+	}
+
+	IFileManager::Get().DeleteDirectory(*WorkingDirectory, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPPackagingBenchmark, "BPixelStreamingGCP.Benchmarks.Packaging", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FPSGCPPackagingBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 Scale = PSGCPBenchmarkUtilities::GetScale();
+	TArray<TSharedPtr<FJsonValue>> Results;
+
+	for (const FPSGCPBenchmarkTreeShape& Shape : BenchmarkTreeShapes)
+	{
+		const FString WorkingDirectory = PSGCPBenchmarkUtilities::GetWorkingDirectory(Shape.Name);
+		const FString SourceDirectory = WorkingDirectory / TEXT("Source");
+		const FString ExtractDirectory = WorkingDirectory / TEXT("Extract");
+		const FString BZipPath = WorkingDirectory / TEXT("BZipFile.zip");
+		const FString ResumableZipPath = WorkingDirectory / TEXT("ResumableZip.zip");
+
+		IFileManager::Get().DeleteDirectory(*WorkingDirectory, false, true);
+
+		const int64 TotalSize = GenerateTree(SourceDirectory, Shape, Scale);
+		if (!TestTrue(FString::Printf(TEXT("%s source tree is generated"), Shape.Name), TotalSize > 0)) continue;
+
+		const double TotalMegabytes = TotalSize / (1024.0 * 1024.0);
+		const int32 FileCount = Shape.SmallFileCount * Scale + Shape.LargeFileCount;
+
+		auto AddResult = [&](const TCHAR* Operation, bool bSucceed, const FString& ErrorMessage, double Seconds, uint64 PeakMemoryDelta)
+		{
+			TestTrue(FString::Printf(TEXT("%s %s succeeds"), Shape.Name, Operation), bSucceed);
+			if (!bSucceed) AddError(ErrorMessage);
+
+			TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+			Result->SetStringField("tree", Shape.Name);
+			Result->SetStringField("operation", Operation);
+			Result->SetBoolField("succeed", bSucceed);
+			Result->SetNumberField("files", FileCount);
+			Result->SetNumberField("bytes", TotalSize);
+			Result->SetNumberField("seconds", Seconds);
+			Result->SetNumberField("megabytesPerSecond", Seconds > 0.0 ? TotalMegabytes / Seconds : 0.0);
+			Result->SetNumberField("peakMemoryDeltaBytes", PeakMemoryDelta);
+			Results.Add(MakeShareable(new FJsonValueObject(Result)));
+		};
+
+		bool bSucceed = false;
+		FString ErrorMessage;
+		uint64 PeakMemoryDelta = 0;
+
+		double Seconds = PSGCPBenchmarkUtilities::MeasureWork([&]()
+			{
+				bSucceed = BZipFile::CompressAll(SourceDirectory, BZipPath, ErrorMessage);
+			}, PeakMemoryDelta);
+		AddResult(TEXT("BZipFile::CompressAll"), bSucceed, ErrorMessage, Seconds, PeakMemoryDelta);
+
+		Seconds = PSGCPBenchmarkUtilities::MeasureWork([&]()
+			{
+				FThreadSafeBool bCancelRequested(false);
+				bool bCancelled = false;
+				bSucceed = PSGCPResumableZip::CompressAll(SourceDirectory, ResumableZipPath, ResumableZipPath + TEXT(".journal"), bCancelRequested, bCancelled, ErrorMessage);
+			}, PeakMemoryDelta);
+		AddResult(TEXT("PSGCPResumableZip::CompressAll"), bSucceed, ErrorMessage, Seconds, PeakMemoryDelta);
+
+		Seconds = PSGCPBenchmarkUtilities::MeasureWork([&]()
+			{
+				bSucceed = BZipFile::ExtractAll(ResumableZipPath, ExtractDirectory, ErrorMessage);
+			}, PeakMemoryDelta);
+		AddResult(TEXT("BZipFile::ExtractAll"), bSucceed, ErrorMessage, Seconds, PeakMemoryDelta);
+
+		IFileManager::Get().DeleteDirectory(*WorkingDirectory, false, true);
+	}
+
+	AddInfo(FString::Printf(TEXT("Results are written to %s"), *PSGCPBenchmarkUtilities::WriteResults(TEXT("Packaging"), Results)));
+	return true;
+}
+
+#endif
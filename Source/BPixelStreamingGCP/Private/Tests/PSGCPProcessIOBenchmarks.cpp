@@ -0,0 +1,246 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "PSGCPBenchmarkUtilities.h"
+#include "Misc/AutomationTest.h"
+#include "PSGCPWidgetBlueprintLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	struct FPSGCPProcessIOConfig
+	{
+		int32 LinesPerSecond;
+		int32 BytesPerLine;
+		int32 DurationSeconds;
+	};
+
+	const FPSGCPProcessIOConfig ProcessIOConfigs[] =
+	{
+		{ 10, 80, 5 },
+		{ 200, 200, 5 },
+		{ 2000, 1024, 5 }
+	};
+
+	//Outputs of CreateHiddenProcess are written from game thread tasks until Exec turns into ProcessExited; the received fields are written
+	//by the output hook on the pipe reader thread under Lock.
+	struct FPSGCPProcessIOState
+	{
+		FProcessHandleWrapper ProcessHandle;
+		FString ReadMessage;
+		int32 ExitCode = 0;
+		PS_GCP_PROCESS_EXEC Exec = PS_GCP_PROCESS_EXEC::DataAvailable;
+
+		FCriticalSection Lock;
+		//Bytes of the last line that has not been terminated yet.
+		TArray<uint8> Carry;
+		int64 ReceivedBytes = 0;
+		int32 ReceivedChunks = 0;
+		TArray<double> LatenciesMs;
+	};
+
+	//Each line the dummy child emits starts with its UTC time in FDateTime ticks.
+	bool BuildDummyChildProcess(const FPSGCPProcessIOConfig& Config, FString& OutProgram, TArray<FString>& OutArgs)
+	{
+#if PLATFORM_WINDOWS
+		const int32 LinesPerBatch = FMath::Max(1, Config.LinesPerSecond / 50);
+		const int32 BatchIntervalMs = 1000 * LinesPerBatch / Config.LinesPerSecond;
+		const int32 BatchCount = Config.DurationSeconds * Config.LinesPerSecond / LinesPerBatch;
+
+		OutProgram = FPlatformMisc::GetEnvironmentVariable(TEXT("SystemRoot")) / TEXT("System32/WindowsPowerShell/v1.0/powershell.exe");
+		OutArgs = {
+			TEXT("-NoProfile"),
+			TEXT("-Command"),
+			FString::Printf(TEXT("$p='x'*%d; for($b=0;$b -lt %d;$b++){ for($l=0;$l -lt %d;$l++){ [Console]::Out.WriteLine([DateTime]::UtcNow.Ticks.ToString() + ' ' + $p) }; [Console]::Out.Flush(); Start-Sleep -Milliseconds %d }"),
+				Config.BytesPerLine, BatchCount, LinesPerBatch, BatchIntervalMs)
+		};
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void SampleLatency(const TArray<uint8>& Line, int64 NowTicks, TArray<double>& OutLatenciesMs)
+	{
+		int64 EmittedTicks = 0;
+		int32 Index = 0;
+		for (; Index < Line.Num() && Line[Index] >= '0' && Line[Index] <= '9'; ++Index)
+		{
+			EmittedTicks = EmittedTicks * 10 + (Line[Index] - '0');
+		}
+		if (Index == 0 || Index == Line.Num() || Line[Index] != ' ') return;
+
+		if (EmittedTicks > 0 && EmittedTicks <= NowTicks)
+		{
+			OutLatenciesMs.Add((NowTicks - EmittedTicks) / (double)ETimespan::TicksPerMillisecond);
+		}
+	}
+
+	//Called on the pipe reader thread as each chunk is read, so every line is timestamped when it is received rather than when a tick sees it.
+	void ReceiveOutput(FPSGCPProcessIOState& State, const TArray<uint8>& Output)
+	{
+		const int64 NowTicks = FDateTime::UtcNow().GetTicks();
+
+		FScopeLock ScopeLock(&State.Lock);
+		State.ReceivedBytes += Output.Num();
+		State.ReceivedChunks++;
+
+		for (uint8 Byte : Output)
+		{
+			if (Byte == '\n')
+			{
+				SampleLatency(State.Carry, NowTicks, State.LatenciesMs);
+				State.Carry.Reset();
+			}
+			else if (Byte != '\r')
+			{
+				State.Carry.Add(Byte);
+			}
+		}
+	}
+
+	double Percentile(TArray<double> Values, double Fraction)
+	{
+		if (Values.Num() == 0) return 0.0;
+		Values.Sort();
+		return Values[FMath::Clamp(FMath::FloorToInt(Fraction * (Values.Num() - 1)), 0, Values.Num() - 1)];
+	}
+}
+
+class FPSGCPProcessIOBenchmarkCommand : public IAutomationLatentCommand
+{
+public:
+	FPSGCPProcessIOBenchmarkCommand(FAutomationTestBase* InTest, const FPSGCPProcessIOConfig& InConfig, TSharedRef<TArray<TSharedPtr<FJsonValue>>> InResults)
+		: Test(InTest), Config(InConfig), Results(InResults), State(MakeShared<FPSGCPProcessIOState, ESPMode::ThreadSafe>())
+	{
+	}
+
+	virtual bool Update() override
+	{
+		const double Now = FPlatformTime::Seconds();
+
+		if (StartTime < 0.0)
+		{
+			FString Program;
+			TArray<FString> Args;
+			if (!BuildDummyChildProcess(Config, Program, Args))
+			{
+				Test->AddWarning(TEXT("The dummy child process is not available on this platform."));
+				return true;
+			}
+
+			StartTime = Now;
+			TSharedRef<FPSGCPProcessIOState, ESPMode::ThreadSafe> HookState = State;
+			if (!UPSGCPWidgetBlueprintLibrary::CreateHiddenProcessWithOutputHook(State->ProcessHandle, Program, Args, State->ReadMessage, State->ExitCode, State->Exec,
+				[HookState](const TArray<uint8>& Output) { ReceiveOutput(*HookState, Output); },
+				FLatentActionInfo(0, FMath::Rand(), TEXT(""), nullptr)))
+			{
+				Test->AddError(FString::Printf(TEXT("Failed to start %s"), *Program));
+				return true;
+			}
+			return false;
+		}
+
+		CPUSamples.Add(FPlatformTime::GetCPUTime().CPUTimePct);
+
+		if (ExitTime < 0.0)
+		{
+			if (FPlatformProcess::IsProcRunning(State->ProcessHandle.ProcessHandle))
+			{
+				if (Now - StartTime > Config.DurationSeconds * 4 + 30)
+				{
+					Test->AddError(TEXT("The dummy child process has timed out."));
+					UPSGCPWidgetBlueprintLibrary::KillCloseHiddenProcess(State->ProcessHandle);
+					ExitTime = Now;
+				}
+				return false;
+			}
+			ExitTime = Now;
+		}
+
+		//Exit is reported from the core ticker after the pipe is drained, so no output is written into State once it is set.
+		if (State->Exec != PS_GCP_PROCESS_EXEC::ProcessExited) return false;
+
+		TArray<double> LatenciesMs;
+		int64 ObservedBytes = 0;
+		int32 ObservedMessages = 0;
+		{
+			FScopeLock ScopeLock(&State->Lock);
+			LatenciesMs = State->LatenciesMs;
+			ObservedBytes = State->ReceivedBytes;
+			ObservedMessages = State->ReceivedChunks;
+		}
+
+		//Payload only; observed bytes also hold the timestamps and line breaks, so loss is decided on the line count.
+		const int64 ExpectedBytes = (int64)Config.LinesPerSecond * Config.BytesPerLine * Config.DurationSeconds;
+		const int64 ExpectedLines = (int64)Config.LinesPerSecond * Config.DurationSeconds;
+		const bool bOutputLost = LatenciesMs.Num() < ExpectedLines;
+		if (bOutputLost)
+		{
+			Test->AddError(FString::Printf(TEXT("At %d lines/s only %d of %lld lines were received."), Config.LinesPerSecond, LatenciesMs.Num(), ExpectedLines));
+		}
+
+		double CPUAverage = 0.0;
+		for (float Sample : CPUSamples) CPUAverage += Sample;
+		CPUAverage = CPUSamples.Num() > 0 ? CPUAverage / CPUSamples.Num() : 0.0;
+
+		double LatencyAverage = 0.0;
+		for (double Latency : LatenciesMs) LatencyAverage += Latency;
+		LatencyAverage = LatenciesMs.Num() > 0 ? LatencyAverage / LatenciesMs.Num() : 0.0;
+
+		TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+		Result->SetNumberField("linesPerSecond", Config.LinesPerSecond);
+		Result->SetNumberField("bytesPerLine", Config.BytesPerLine);
+		Result->SetNumberField("durationSeconds", ExitTime - StartTime);
+		Result->SetNumberField("observedMessages", ObservedMessages);
+		Result->SetNumberField("observedBytes", ObservedBytes);
+		Result->SetNumberField("expectedBytes", ExpectedBytes);
+		Result->SetNumberField("expectedLines", ExpectedLines);
+		Result->SetNumberField("observedLines", LatenciesMs.Num());
+		Result->SetBoolField("outputLost", bOutputLost);
+		Result->SetNumberField("latencySamples", LatenciesMs.Num());
+		Result->SetNumberField("latencyAverageMs", LatencyAverage);
+		Result->SetNumberField("latencyP50Ms", Percentile(LatenciesMs, 0.5));
+		Result->SetNumberField("latencyP95Ms", Percentile(LatenciesMs, 0.95));
+		Result->SetNumberField("latencyMaxMs", Percentile(LatenciesMs, 1.0));
+		Result->SetNumberField("processCPUPercentAverage", CPUAverage);
+		Results->Add(MakeShareable(new FJsonValueObject(Result)));
+
+		Test->TestTrue(FString::Printf(TEXT("Output is received at %d lines/s"), Config.LinesPerSecond), ObservedMessages > 0);
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	FPSGCPProcessIOConfig Config;
+	TSharedRef<TArray<TSharedPtr<FJsonValue>>> Results;
+	TSharedRef<FPSGCPProcessIOState, ESPMode::ThreadSafe> State;
+
+	double StartTime = -1.0;
+	double ExitTime = -1.0;
+	TArray<float> CPUSamples;
+};
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FPSGCPWriteProcessIOResultsCommand, FAutomationTestBase*, Test, TSharedRef<TArray<TSharedPtr<FJsonValue>>>, Results);
+
+bool FPSGCPWriteProcessIOResultsCommand::Update()
+{
+	Test->AddInfo(FString::Printf(TEXT("Results are written to %s"), *PSGCPBenchmarkUtilities::WriteResults(TEXT("ProcessIO"), *Results)));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPProcessIOBenchmark, "BPixelStreamingGCP.Benchmarks.ProcessIO", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FPSGCPProcessIOBenchmark::RunTest(const FString& Parameters)
+{
+	TSharedRef<TArray<TSharedPtr<FJsonValue>>> Results = MakeShared<TArray<TSharedPtr<FJsonValue>>>();
+
+	for (const FPSGCPProcessIOConfig& Config : ProcessIOConfigs)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FPSGCPProcessIOBenchmarkCommand(this, Config, Results));
+	}
+	ADD_LATENT_AUTOMATION_COMMAND(FPSGCPWriteProcessIOResultsCommand(this, Results));
+	return true;
+}
+
+#endif
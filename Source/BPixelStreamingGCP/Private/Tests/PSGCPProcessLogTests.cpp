@@ -0,0 +1,181 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Math/RandomStream.h"
+#include "HAL/FileManager.h"
+#include "PSGCPProcessLog.h"
+#include "PSGCPBenchmarkUtilities.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPProcessLogTest, "BPixelStreamingGCP.ProcessLog.RotateReadFilter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPSGCPProcessLogTest::RunTest(const FString& Parameters)
+{
+	const FString Folder = PSGCPBenchmarkUtilities::GetWorkingDirectory(TEXT("ProcessLog"));
+	IFileManager::Get().DeleteDirectory(*Folder, false, true);
+
+	FString ErrorMessage;
+
+	//Small segments and ring, so rotation, dropping and a full ring are all exercised.
+	PSGCPProcessLog::FPtr Log = PSGCPProcessLog::Create(Folder, FString::Printf(TEXT("Rotate_%s"), *FGuid::NewGuid().ToString()), ErrorMessage, 4 * 1024, 3, 256);
+	if (!TestTrue(FString::Printf(TEXT("Log is created. %s"), *ErrorMessage), Log.IsValid())) return false;
+
+	const int32 LineCount = 2000;
+	FString Output;
+	for (int32 i = 0; i < LineCount; i++)
+	{
+		Output += FString::Printf(i % 3 == 0 ? TEXT("Line %d\r\n") : TEXT("line %d\n"), i);
+	}
+	Output += TEXT("unterminated");
+	FTCHARToUTF8 Utf8Output(*Output);
+
+	//Pipe reads arrive in arbitrary chunks, splitting lines and line endings.
+	FRandomStream Random(30);
+	for (int32 Offset = 0; Offset < Utf8Output.Length();)
+	{
+		const int32 ChunkSize = FMath::Min(Random.RandRange(1, 700), Utf8Output.Length() - Offset);
+		Log->Append((const uint8*)Utf8Output.Get() + Offset, ChunkSize);
+		Offset += ChunkSize;
+	}
+	Log->Close();
+
+	int64 FirstLine = 0;
+	int64 AvailableLineCount = 0;
+	Log->GetLineRange(FirstLine, AvailableLineCount);
+	TestEqual(TEXT("Line numbering survives dropped segments"), FirstLine + AvailableLineCount, (int64)LineCount + 1);
+	TestTrue(TEXT("Oldest segments are dropped"), FirstLine > 0);
+
+	//The ring is freed by Close; later output is ignored.
+	Log->Append((const uint8*)"late\n", 5);
+	Log->GetLineRange(FirstLine, AvailableLineCount);
+	TestEqual(TEXT("Output after Close is ignored"), FirstLine + AvailableLineCount, (int64)LineCount + 1);
+
+	TArray<FString> SegmentFiles;
+	IFileManager::Get().FindFiles(SegmentFiles, *(Folder / (Log->GetName() + TEXT(".*.log"))), true, false);
+	TestEqual(TEXT("At most MaxSegments files are kept"), SegmentFiles.Num(), 3);
+
+	TArray<FString> Lines;
+	int64 PageFirstLine = 0;
+	TestTrue(TEXT("Reading from before the first line succeeds"), Log->ReadLines(0, 10, PageFirstLine, Lines, ErrorMessage));
+	TestEqual(TEXT("Reads are clamped to the first line on disk"), PageFirstLine, FirstLine);
+
+	//Pages starting at, before and after index checkpoints.
+	for (int64 StartLine : { FirstLine, FirstLine + 1, FirstLine + 63, FirstLine + 64, FirstLine + 65, (int64)LineCount - 5 })
+	{
+		TestTrue(TEXT("Page is read"), Log->ReadLines(StartLine, 10, PageFirstLine, Lines, ErrorMessage));
+		for (int32 i = 0; i < Lines.Num(); i++)
+		{
+			const int64 LineNumber = PageFirstLine + i;
+			const FString Expected = LineNumber == LineCount
+				? FString(TEXT("unterminated"))
+				: FString::Printf(LineNumber % 3 == 0 ? TEXT("Line %lld") : TEXT("line %lld"), LineNumber);
+			TestEqual(FString::Printf(TEXT("Line %lld"), LineNumber), Lines[i], Expected);
+		}
+		TestEqual(TEXT("Page size"), (int64)Lines.Num(), FMath::Min<int64>(10, LineCount + 1 - StartLine));
+	}
+
+	TArray<int64> LineNumbers;
+	int64 NextLine = 0;
+	TestTrue(TEXT("Filter succeeds"), Log->FilterLines(TEXT("LINE 1999"), 0, 5, LineNumbers, Lines, NextLine, ErrorMessage));
+	TestTrue(TEXT("Filter is case insensitive"), LineNumbers.Num() == 1 && LineNumbers[0] == 1999 && Lines[0] == TEXT("line 1999"));
+	TestEqual(TEXT("Filter continues after the last line when done"), NextLine, (int64)LineCount + 1);
+
+	TestTrue(TEXT("Paged filter succeeds"), Log->FilterLines(TEXT("ine 19"), 0, 4, LineNumbers, Lines, NextLine, ErrorMessage));
+	TestTrue(TEXT("Paged filter stops at MaxResults"), LineNumbers.Num() == 4 && NextLine == LineNumbers.Last() + 1);
+
+	//A log left behind by a previous session is indexed from disk, including a partial last line.
+	const FString OldName = FString::Printf(TEXT("Old_%s"), *FGuid::NewGuid().ToString());
+	FFileHelper::SaveStringToFile(TEXT("first\nsecond\nthird"), *(Folder / (OldName + TEXT(".0.log"))));
+
+	PSGCPProcessLog::FPtr OldLog = PSGCPProcessLog::FindOrOpen(Folder, OldName, ErrorMessage);
+	if (TestTrue(TEXT("Existing log is opened"), OldLog.IsValid()))
+	{
+		OldLog->GetLineRange(FirstLine, AvailableLineCount);
+		TestEqual(TEXT("Existing log line count"), AvailableLineCount, (int64)3);
+		TestTrue(TEXT("Existing log is read"), OldLog->ReadLines(1, 10, PageFirstLine, Lines, ErrorMessage) && Lines.Num() == 2 && Lines[1] == TEXT("third"));
+	}
+
+	TestTrue(TEXT("Missing log is reported"), !PSGCPProcessLog::FindOrOpen(Folder, TEXT("Missing"), ErrorMessage).IsValid());
+
+	TArray<FString> Names;
+	PSGCPProcessLog::ListLogs(Folder, Names);
+	TestEqual(TEXT("Both logs are listed"), Names.Num(), 2);
+
+	PSGCPProcessLog::PruneLogs(Folder, 0);
+	PSGCPProcessLog::ListLogs(Folder, Names);
+	TestEqual(TEXT("Closed logs are pruned"), Names.Num(), 0);
+
+	IFileManager::Get().DeleteDirectory(*Folder, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPProcessLogLongLineTest, "BPixelStreamingGCP.ProcessLog.LongLines", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPSGCPProcessLogLongLineTest::RunTest(const FString& Parameters)
+{
+	const FString Folder = PSGCPBenchmarkUtilities::GetWorkingDirectory(TEXT("ProcessLogLongLines"));
+	IFileManager::Get().DeleteDirectory(*Folder, false, true);
+
+	FString ErrorMessage;
+
+	const int64 MaxSegmentSize = 4 * 1024;
+	PSGCPProcessLog::FPtr Log = PSGCPProcessLog::Create(Folder, FString::Printf(TEXT("Progress_%s"), *FGuid::NewGuid().ToString()), ErrorMessage, MaxSegmentSize, 16, 256);
+	if (!TestTrue(FString::Printf(TEXT("Log is created. %s"), *ErrorMessage), Log.IsValid())) return false;
+
+	//A progress bar redraws with '\r' only; three and a half capped lines of it, then a terminated line.
+	const int32 ProgressLength = PSGCP_PROCESS_LOG_MAX_LINE_LENGTH * 3 + PSGCP_PROCESS_LOG_MAX_LINE_LENGTH / 2;
+	TArray<uint8> Progress;
+	Progress.Reserve(ProgressLength);
+	while (Progress.Num() < ProgressLength)
+	{
+		Progress.Add(Progress.Num() % 10 == 9 ? '\r' : '#');
+	}
+	for (int32 Offset = 0; Offset < Progress.Num(); Offset += 1000)
+	{
+		Log->Append(Progress.GetData() + Offset, FMath::Min(1000, Progress.Num() - Offset));
+	}
+	Log->Append((const uint8*)"done\n", 5);
+	Log->Close();
+
+	int64 FirstLine = 0;
+	int64 AvailableLineCount = 0;
+	Log->GetLineRange(FirstLine, AvailableLineCount);
+	TestEqual(TEXT("Output without line breaks is broken into capped lines"), FirstLine + AvailableLineCount, (int64)4);
+
+	TArray<FString> SegmentFiles;
+	IFileManager::Get().FindFiles(SegmentFiles, *(Folder / (Log->GetName() + TEXT(".*.log"))), true, false);
+	TestTrue(TEXT("Segments rotate at the forced line breaks"), SegmentFiles.Num() >= 4);
+	for (const FString& SegmentFile : SegmentFiles)
+	{
+		TestTrue(TEXT("Segment stays bounded"), IFileManager::Get().FileSize(*(Folder / SegmentFile)) <= MaxSegmentSize + PSGCP_PROCESS_LOG_MAX_LINE_LENGTH + 1);
+	}
+
+	TArray<FString> Lines;
+	int64 PageFirstLine = 0;
+	TestTrue(TEXT("Capped lines are read"), Log->ReadLines(0, 10, PageFirstLine, Lines, ErrorMessage));
+	if (TestEqual(TEXT("Capped line count"), Lines.Num(), 4))
+	{
+		TestEqual(TEXT("Capped line length"), Lines[0].Len(), PSGCP_PROCESS_LOG_MAX_LINE_LENGTH);
+		TestTrue(TEXT("Remainder is kept with the terminated line"), Lines[3].EndsWith(TEXT("done")) && Lines[3].Len() == PSGCP_PROCESS_LOG_MAX_LINE_LENGTH / 2 + 4);
+	}
+
+	//A log from before lines were capped is read with the long line truncated.
+	const FString OldName = FString::Printf(TEXT("Uncapped_%s"), *FGuid::NewGuid().ToString());
+	FFileHelper::SaveStringToFile(FString::ChrN(PSGCP_PROCESS_LOG_MAX_LINE_LENGTH * 4, TEXT('#')) + TEXT("\nshort\n"), *(Folder / (OldName + TEXT(".0.log"))));
+
+	PSGCPProcessLog::FPtr OldLog = PSGCPProcessLog::FindOrOpen(Folder, OldName, ErrorMessage);
+	if (TestTrue(TEXT("Uncapped log is opened"), OldLog.IsValid()))
+	{
+		TestTrue(TEXT("Uncapped log is read"), OldLog->ReadLines(0, 10, PageFirstLine, Lines, ErrorMessage) && Lines.Num() == 2);
+		TestTrue(TEXT("Long line is truncated and numbering is kept"), Lines.Num() == 2 && Lines[0].Len() == PSGCP_PROCESS_LOG_MAX_LINE_LENGTH && Lines[1] == TEXT("short"));
+	}
+
+	PSGCPProcessLog::PruneLogs(Folder, 0);
+	IFileManager::Get().DeleteDirectory(*Folder, false, true);
+	return true;
+}
+
+#endif
@@ -0,0 +1,340 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "PSGCPProcessorUpdater.h"
+#include "PSGCPBenchmarkUtilities.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	void AppendPatchValue(TArray<uint8>& Patch, uint64 Value)
+	{
+		for (int32 i = 0; i < 8; i++)
+		{
+			Patch.Add((uint8)(Value >> (i * 8)));
+		}
+	}
+
+	TArray<uint8> MakePatchHeader(uint64 TargetSize)
+	{
+		TArray<uint8> Patch;
+		Patch.Append((const uint8*)"PSGCPDF1", 8);
+		AppendPatchValue(Patch, TargetSize);
+		return Patch;
+	}
+
+	void AppendCopy(TArray<uint8>& Patch, uint64 SourceOffset, uint64 Length)
+	{
+		Patch.Add(1);
+		AppendPatchValue(Patch, SourceOffset);
+		AppendPatchValue(Patch, Length);
+	}
+
+	void AppendInsert(TArray<uint8>& Patch, const ANSICHAR* Bytes)
+	{
+		const int32 Length = FCStringAnsi::Strlen(Bytes);
+		Patch.Add(2);
+		AppendPatchValue(Patch, Length);
+		Patch.Append((const uint8*)Bytes, Length);
+	}
+
+	TArray<uint8> ToBytes(const ANSICHAR* Text)
+	{
+		TArray<uint8> Bytes;
+		Bytes.Append((const uint8*)Text, FCStringAnsi::Strlen(Text));
+		return Bytes;
+	}
+
+	FString Sha1Of(const TArray<uint8>& Bytes)
+	{
+		uint8 Hash[FSHA1::DigestSize];
+		FSHA1::HashBuffer(Bytes.GetData(), Bytes.Num(), Hash);
+		return BytesToHex(Hash, FSHA1::DigestSize);
+	}
+
+	FString ManifestFileEntry(const FString& Path, const TArray<uint8>& Content, const FString& Patches = TEXT(""))
+	{
+		return FString::Printf(TEXT("{\"path\":\"%s\",\"size\":%d,\"sha1\":\"%s\",\"url\":\"files/%s\",\"patches\":[%s]}"),
+			*Path, Content.Num(), *Sha1Of(Content), *Path, *Patches);
+	}
+
+	FString Manifest(int64 ZipSize, const TArray<FString>& FileEntries)
+	{
+		return FString::Printf(TEXT("{\"zipSize\":%lld,\"files\":[%s]}"), ZipSize, *FString::Join(FileEntries, TEXT(",")));
+	}
+
+	bool FileContentEquals(const FString& Path, const TArray<uint8>& Expected)
+	{
+		TArray<uint8> Content;
+		return FFileHelper::LoadFileToArray(Content, *Path) && Content == Expected;
+	}
+
+	TArray<uint8> RandomBytes(FRandomStream& Random, int32 Count)
+	{
+		TArray<uint8> Bytes;
+		Bytes.SetNumUninitialized(Count);
+		for (uint8& Byte : Bytes)
+		{
+			Byte = (uint8)Random.RandRange(0, 255);
+		}
+		return Bytes;
+	}
+
+	//Overwrites, inserts and removes a few runs, like a rebuilt binary.
+	TArray<uint8> EditBytes(FRandomStream& Random, TArray<uint8> Bytes)
+	{
+		for (int32 Edit = 0; Edit < 8 && Bytes.Num() > 0; Edit++)
+		{
+			const int32 Offset = Random.RandRange(0, Bytes.Num() - 1);
+			const int32 Length = FMath::Min(Random.RandRange(1, 200), Bytes.Num() - Offset);
+			switch (Edit % 3)
+			{
+			case 0: FMemory::Memcpy(Bytes.GetData() + Offset, RandomBytes(Random, Length).GetData(), Length); break;
+			case 1: Bytes.Insert(RandomBytes(Random, Length), Offset); break;
+			default: Bytes.RemoveAt(Offset, Length); break;
+			}
+		}
+		return Bytes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPProcessorUpdaterPatchTest, "BPixelStreamingGCP.ProcessorUpdater.ApplyBinaryPatch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPSGCPProcessorUpdaterPatchTest::RunTest(const FString& Parameters)
+{
+	TArray<uint8> Source;
+	Source.Append((const uint8*)"hello old world", 15);
+
+	TArray<uint8> Target;
+	FString ErrorMessage;
+
+	//"hello " + "new" + " world"
+	TArray<uint8> Patch = MakePatchHeader(15);
+	AppendCopy(Patch, 0, 6);
+	AppendInsert(Patch, "new");
+	AppendCopy(Patch, 9, 6);
+	Patch.Add(0);
+	TestTrue(TEXT("Valid patch applies"), PSGCPProcessorUpdater::ApplyBinaryPatch(Source, Patch, 15, Target, ErrorMessage));
+	TestTrue(TEXT("Patched content matches"), Target.Num() == 15 && FMemory::Memcmp(Target.GetData(), "hello new world", 15) == 0);
+
+	Patch = MakePatchHeader(6);
+	AppendCopy(Patch, 10, 6);
+	Patch.Add(0);
+	TestFalse(TEXT("Copy past the source end is rejected"), PSGCPProcessorUpdater::ApplyBinaryPatch(Source, Patch, 6, Target, ErrorMessage));
+
+	Patch = MakePatchHeader(16);
+	AppendCopy(Patch, 0, 15);
+	Patch.Add(0);
+	TestFalse(TEXT("Target size mismatch is rejected"), PSGCPProcessorUpdater::ApplyBinaryPatch(Source, Patch, 16, Target, ErrorMessage));
+
+	Patch = MakePatchHeader(3);
+	AppendInsert(Patch, "new");
+	Patch.SetNum(Patch.Num() - 1);
+	TestFalse(TEXT("Truncated insert is rejected"), PSGCPProcessorUpdater::ApplyBinaryPatch(Source, Patch, 3, Target, ErrorMessage));
+
+	Patch = MakePatchHeader(3);
+	AppendInsert(Patch, "new");
+	TestFalse(TEXT("Missing end op is rejected"), PSGCPProcessorUpdater::ApplyBinaryPatch(Source, Patch, 3, Target, ErrorMessage));
+
+	Patch = MakePatchHeader(0);
+	Patch[0] = 'X';
+	Patch.Add(0);
+	TestFalse(TEXT("Bad magic is rejected"), PSGCPProcessorUpdater::ApplyBinaryPatch(Source, Patch, 0, Target, ErrorMessage));
+
+	Patch = MakePatchHeader(0);
+	Patch.Add(7);
+	TestFalse(TEXT("Unknown op is rejected"), PSGCPProcessorUpdater::ApplyBinaryPatch(Source, Patch, 0, Target, ErrorMessage));
+
+	//A header claiming a huge target is rejected before anything is allocated for it.
+	Patch = MakePatchHeader(MAX_int32);
+	AppendCopy(Patch, 0, 15);
+	Patch.Add(0);
+	TestFalse(TEXT("Target size other than the manifest size is rejected"), PSGCPProcessorUpdater::ApplyBinaryPatch(Source, Patch, 15, Target, ErrorMessage));
+	TestTrue(TEXT("Nothing is allocated for a rejected target size"), Target.Max() < 1024);
+
+	//Generated patches reproduce the target and only carry the edited bytes.
+	FRandomStream Random(29);
+	const TArray<uint8> Original = RandomBytes(Random, 64 * 1024);
+	const TArray<uint8> Edited = EditBytes(Random, Original);
+	PSGCPProcessorUpdater::MakeBinaryPatch(Original, Edited, Patch);
+	TestTrue(TEXT("Generated patch applies"), PSGCPProcessorUpdater::ApplyBinaryPatch(Original, Patch, Edited.Num(), Target, ErrorMessage) && Target == Edited);
+	TestTrue(TEXT("Generated patch is small"), Patch.Num() < Edited.Num() / 8);
+
+	for (const TArray<uint8>& PatchSource : { TArray<uint8>(), Source, Original })
+	{
+		for (const TArray<uint8>& PatchTarget : { TArray<uint8>(), Source, Edited })
+		{
+			PSGCPProcessorUpdater::MakeBinaryPatch(PatchSource, PatchTarget, Patch);
+			TestTrue(TEXT("Generated patch applies to any pair"), PSGCPProcessorUpdater::ApplyBinaryPatch(PatchSource, Patch, PatchTarget.Num(), Target, ErrorMessage) && Target == PatchTarget);
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPProcessorUpdaterManifestTest, "BPixelStreamingGCP.ProcessorUpdater.PatchUpdateFromManifest", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPSGCPProcessorUpdaterManifestTest::RunTest(const FString& Parameters)
+{
+	const FString WorkingDirectory = PSGCPBenchmarkUtilities::GetWorkingDirectory(TEXT("ProcessorUpdater"));
+	const FString Installed = WorkingDirectory / TEXT("ps_unreal_plugin_processor");
+	const FString Staging = WorkingDirectory / TEXT("ps_unreal_plugin_processor_staging");
+
+	const TArray<uint8> Unchanged = ToBytes("unchanged");
+	const TArray<uint8> OldPatched = ToBytes("hello old world");
+	const TArray<uint8> NewPatched = ToBytes("hello new world");
+	const TArray<uint8> Stale = ToBytes("stale");
+	const TArray<uint8> Fresh = ToBytes("fresh content");
+	const TArray<uint8> Added = ToBytes("added in this release");
+
+	auto ResetInstalled = [&]()
+	{
+		IFileManager::Get().DeleteDirectory(*WorkingDirectory, false, true);
+		FFileHelper::SaveArrayToFile(Unchanged, *(Installed / TEXT("keep.txt")));
+		FFileHelper::SaveArrayToFile(OldPatched, *(Installed / TEXT("bin/patched.bin")));
+		FFileHelper::SaveArrayToFile(Stale, *(Installed / TEXT("download.txt")));
+		FFileHelper::SaveArrayToFile(Stale, *(Installed / TEXT("extra.txt")));
+	};
+
+	TArray<uint8> Patch = MakePatchHeader(NewPatched.Num());
+	AppendCopy(Patch, 0, 6);
+	AppendInsert(Patch, "new");
+	AppendCopy(Patch, 9, 6);
+	Patch.Add(0);
+
+	TMap<FString, TArray<uint8>> Served;
+	Served.Add(TEXT("files/download.txt"), Fresh);
+	Served.Add(TEXT("files/new/added.txt"), Added);
+	Served.Add(TEXT("patches/patched.bin"), Patch);
+
+	TArray<FString> Fetched;
+	auto Fetch = [&](const FString& Url, TArray<uint8>& OutContent)
+	{
+		Fetched.Add(Url);
+		const TArray<uint8>* Content = Served.Find(Url);
+		if (Content) OutContent = *Content;
+		return Content != nullptr;
+	};
+
+	const TArray<FString> FileEntries = {
+		ManifestFileEntry(TEXT("keep.txt"), Unchanged),
+		ManifestFileEntry(TEXT("bin/patched.bin"), NewPatched, FString::Printf(TEXT("{\"fromSha1\":\"%s\",\"size\":%d,\"url\":\"patches/patched.bin\"}"), *Sha1Of(OldPatched), Patch.Num())),
+		ManifestFileEntry(TEXT("download.txt"), Fresh),
+		ManifestFileEntry(TEXT("new/added.txt"), Added)
+	};
+
+	FString ErrorMessage;
+
+	//Keep, patch and download; extra.txt is not in the manifest.
+	ResetInstalled();
+	if (!TestTrue(TEXT("Patch update succeeds"), PSGCPProcessorUpdater::PatchUpdateFromManifest(Manifest(1024 * 1024, FileEntries), Installed, Staging, Fetch, ErrorMessage)))
+	{
+		AddError(ErrorMessage);
+	}
+	Fetched.Sort();
+	TestTrue(TEXT("Only patches and changed files are fetched"), Fetched == TArray<FString>({ TEXT("files/download.txt"), TEXT("files/new/added.txt"), TEXT("patches/patched.bin") }));
+	TestTrue(TEXT("Unchanged file is kept"), FileContentEquals(Installed / TEXT("keep.txt"), Unchanged));
+	TestTrue(TEXT("Changed file is patched"), FileContentEquals(Installed / TEXT("bin/patched.bin"), NewPatched));
+	TestTrue(TEXT("File without a matching patch is downloaded"), FileContentEquals(Installed / TEXT("download.txt"), Fresh));
+	TestTrue(TEXT("Missing file is downloaded"), FileContentEquals(Installed / TEXT("new/added.txt"), Added));
+	TestFalse(TEXT("File missing from the manifest is dropped"), IFileManager::Get().FileExists(*(Installed / TEXT("extra.txt"))));
+	TestFalse(TEXT("Staging folder is moved in place"), IFileManager::Get().DirectoryExists(*Staging));
+	TestFalse(TEXT("Previous version is removed"), IFileManager::Get().DirectoryExists(*(Installed + TEXT("_previous"))));
+
+	//The same release again: every file is kept and nothing is fetched.
+	Fetched.Reset();
+	TestTrue(TEXT("Up to date release succeeds"), PSGCPProcessorUpdater::PatchUpdateFromManifest(Manifest(1024 * 1024, FileEntries), Installed, Staging, Fetch, ErrorMessage));
+	TestEqual(TEXT("Up to date release fetches nothing"), Fetched.Num(), 0);
+
+	//Above 70% of the zip size the full release is preferred, before anything is fetched.
+	ResetInstalled();
+	Fetched.Reset();
+	TestFalse(TEXT("Large patch falls back"), PSGCPProcessorUpdater::PatchUpdateFromManifest(Manifest(Fresh.Num() + Added.Num(), FileEntries), Installed, Staging, Fetch, ErrorMessage));
+	TestTrue(TEXT("Fallback reports the download size"), ErrorMessage.StartsWith(TEXT("Patch would download")));
+	TestEqual(TEXT("Fallback fetches nothing"), Fetched.Num(), 0);
+	TestTrue(TEXT("Installed file is untouched after a fallback"), FileContentEquals(Installed / TEXT("download.txt"), Stale));
+
+	//A served file that does not match its manifest hash leaves the installed version untouched.
+	Served.Add(TEXT("files/download.txt"), ToBytes("tampered"));
+	TestFalse(TEXT("Hash mismatch fails"), PSGCPProcessorUpdater::PatchUpdateFromManifest(Manifest(1024 * 1024, FileEntries), Installed, Staging, Fetch, ErrorMessage));
+	TestTrue(TEXT("Installed file is untouched after a hash mismatch"), FileContentEquals(Installed / TEXT("download.txt"), Stale));
+	TestTrue(TEXT("Installed file that would be patched is untouched"), FileContentEquals(Installed / TEXT("bin/patched.bin"), OldPatched));
+	TestTrue(TEXT("Unlisted installed file survives a failed update"), IFileManager::Get().FileExists(*(Installed / TEXT("extra.txt"))));
+	TestFalse(TEXT("Staging folder is removed after a failure"), IFileManager::Get().DirectoryExists(*Staging));
+
+	IFileManager::Get().DeleteDirectory(*WorkingDirectory, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSGCPProcessorUpdaterReleaseTest, "BPixelStreamingGCP.ProcessorUpdater.BuildRelease", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPSGCPProcessorUpdaterReleaseTest::RunTest(const FString& Parameters)
+{
+	const FString WorkingDirectory = PSGCPBenchmarkUtilities::GetWorkingDirectory(TEXT("ProcessorRelease"));
+	const FString Previous = WorkingDirectory / TEXT("Previous");
+	const FString Release = WorkingDirectory / TEXT("Release");
+	const FString Output = WorkingDirectory / TEXT("releases");
+	const FString Installed = WorkingDirectory / TEXT("ps_unreal_plugin_processor");
+	const FString Staging = WorkingDirectory / TEXT("ps_unreal_plugin_processor_staging");
+	IFileManager::Get().DeleteDirectory(*WorkingDirectory, false, true);
+
+	FRandomStream Random(31);
+	const TArray<uint8> OldExe = RandomBytes(Random, 256 * 1024);
+	const TArray<uint8> NewExe = EditBytes(Random, OldExe);
+	const TArray<uint8> Settings = ToBytes("{\"port\":8080}");
+	const TArray<uint8> Removed = RandomBytes(Random, 1024);
+	const TArray<uint8> Added = ToBytes("added in this release");
+
+	for (const FString& Folder : { Previous, Installed })
+	{
+		FFileHelper::SaveArrayToFile(OldExe, *(Folder / TEXT("PixelStreamingUnrealEditorPluginProcessor.exe")));
+		FFileHelper::SaveArrayToFile(Settings, *(Folder / TEXT("config/settings.json")));
+		FFileHelper::SaveArrayToFile(Removed, *(Folder / TEXT("removed.dll")));
+	}
+	FFileHelper::SaveArrayToFile(NewExe, *(Release / TEXT("PixelStreamingUnrealEditorPluginProcessor.exe")));
+	FFileHelper::SaveArrayToFile(Settings, *(Release / TEXT("config/settings.json")));
+	FFileHelper::SaveArrayToFile(Added, *(Release / TEXT("new folder/added.txt")));
+
+	FString ErrorMessage;
+	if (!TestTrue(TEXT("Release is built"), PSGCPProcessorUpdater::BuildRelease(Release, { Previous }, Output, ErrorMessage)))
+	{
+		AddError(ErrorMessage);
+		return false;
+	}
+	TestTrue(TEXT("Full release zip is written"), IFileManager::Get().FileSize(*(Output / TEXT(PSGCP_PROCESSOR_RELEASE_ZIP_NAME))) > 0);
+
+	FString ManifestJson;
+	TestTrue(TEXT("Manifest is written"), FFileHelper::LoadFileToString(ManifestJson, *(Output / TEXT(PSGCP_PROCESSOR_RELEASE_MANIFEST_NAME))));
+
+	//The output folder stands in for releases/ in the bucket.
+	TArray<FString> Fetched;
+	auto Fetch = [&](const FString& Url, TArray<uint8>& OutContent)
+	{
+		Fetched.Add(Url);
+		return FFileHelper::LoadFileToArray(OutContent, *(Output / FGenericPlatformHttp::UrlDecode(Url)));
+	};
+
+	if (!TestTrue(TEXT("Installed previous release is patched"), PSGCPProcessorUpdater::PatchUpdateFromManifest(ManifestJson, Installed, Staging, Fetch, ErrorMessage)))
+	{
+		AddError(ErrorMessage);
+	}
+	TestTrue(TEXT("Changed binary is patched"), FileContentEquals(Installed / TEXT("PixelStreamingUnrealEditorPluginProcessor.exe"), NewExe));
+	TestTrue(TEXT("Unchanged file is kept"), FileContentEquals(Installed / TEXT("config/settings.json"), Settings));
+	TestTrue(TEXT("Added file is downloaded"), FileContentEquals(Installed / TEXT("new folder/added.txt"), Added));
+	TestFalse(TEXT("File removed from the release is dropped"), IFileManager::Get().FileExists(*(Installed / TEXT("removed.dll"))));
+
+	TestEqual(TEXT("Only the patch and the added file are fetched"), Fetched.Num(), 2);
+	TestTrue(TEXT("Urls are encoded"), Fetched.Contains(TEXT("files/new%20folder/added.txt")));
+	TestTrue(TEXT("Binary is fetched as a patch"), Fetched.ContainsByPredicate([](const FString& Url) { return Url.StartsWith(TEXT("patches/PixelStreamingUnrealEditorPluginProcessor.exe.")); }));
+
+	IFileManager::Get().DeleteDirectory(*WorkingDirectory, false, true);
+	return true;
+}
+
+#endif
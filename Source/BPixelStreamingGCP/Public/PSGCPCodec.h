@@ -0,0 +1,91 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EPSGCPCodecKernel : uint8
+{
+	Auto = 0,
+	Scalar = 1,
+	SSSE3 = 2,
+	AVX2 = 3
+};
+
+/**
+ * Hex and base64 (RFC 4648, standard alphabet) encoding into caller provided buffers; nothing is allocated.
+ * Outputs are not null terminated. An unsupported kernel falls back to the best supported one below it.
+ */
+class BPIXELSTREAMINGGCP_API PSGCPCodec
+{
+public:
+	static bool IsKernelSupported(EPSGCPCodecKernel Kernel);
+
+	static int64 HexEncodedLength(int64 ByteCount) { return ByteCount * 2; }
+	static int64 HexMaxDecodedLength(int64 CharCount) { return (CharCount + 1) / 2; }
+
+	//Hex encoding is stateless; large buffers can be streamed by encoding them chunk by chunk.
+	static void HexEncode(const uint8* Src, int64 Count, ANSICHAR* Dst, bool bUpperCase = false, EPSGCPCodecKernel Kernel = EPSGCPCodecKernel::Auto);
+
+	//Accepts both cases; fails on an odd length or a non-hex character.
+	static bool HexDecode(const ANSICHAR* Src, int64 Count, uint8* Dst, int64& OutWritten, EPSGCPCodecKernel Kernel = EPSGCPCodecKernel::Auto);
+
+	static int64 Base64EncodedLength(int64 ByteCount) { return (ByteCount + 2) / 3 * 4; }
+	static int64 Base64MaxDecodedLength(int64 CharCount) { return (CharCount + 3) / 4 * 3; }
+
+	static int64 Base64Encode(const uint8* Src, int64 Count, ANSICHAR* Dst, EPSGCPCodecKernel Kernel = EPSGCPCodecKernel::Auto);
+
+	//Padding is optional; whitespace and characters outside the alphabet fail.
+	static bool Base64Decode(const ANSICHAR* Src, int64 Count, uint8* Dst, int64& OutWritten, EPSGCPCodecKernel Kernel = EPSGCPCodecKernel::Auto);
+
+	class BPIXELSTREAMINGGCP_API FHexDecoder
+	{
+	public:
+		explicit FHexDecoder(EPSGCPCodecKernel InKernel = EPSGCPCodecKernel::Auto) : Kernel(InKernel) {}
+
+		//Dst must have room for MaxUpdateLength(Count) bytes.
+		int64 MaxUpdateLength(int64 Count) const { return (Count + (PendingNibble >= 0 ? 1 : 0)) / 2; }
+		bool Update(const ANSICHAR* Src, int64 Count, uint8* Dst, int64& OutWritten);
+		bool Finish() const { return !bFailed && PendingNibble < 0; }
+
+	private:
+		EPSGCPCodecKernel Kernel;
+		int32 PendingNibble = -1;
+		bool bFailed = false;
+	};
+
+	class BPIXELSTREAMINGGCP_API FBase64Encoder
+	{
+	public:
+		explicit FBase64Encoder(EPSGCPCodecKernel InKernel = EPSGCPCodecKernel::Auto) : Kernel(InKernel) {}
+
+		//Dst must have room for MaxUpdateLength(Count) characters; Finish writes at most 4.
+		int64 MaxUpdateLength(int64 Count) const { return (Count + PendingCount) / 3 * 4; }
+		int64 Update(const uint8* Src, int64 Count, ANSICHAR* Dst);
+		int64 Finish(ANSICHAR* Dst);
+
+	private:
+		EPSGCPCodecKernel Kernel;
+		uint8 Pending[2] = { 0, 0 };
+		int32 PendingCount = 0;
+	};
+
+	class BPIXELSTREAMINGGCP_API FBase64Decoder
+	{
+	public:
+		explicit FBase64Decoder(EPSGCPCodecKernel InKernel = EPSGCPCodecKernel::Auto) : Kernel(InKernel) {}
+
+		//Dst must have room for MaxUpdateLength(Count) bytes; Finish writes at most 2.
+		int64 MaxUpdateLength(int64 Count) const { return (Count + QuantumCount + PaddingCount) / 4 * 3; }
+		bool Update(const ANSICHAR* Src, int64 Count, uint8* Dst, int64& OutWritten);
+		bool Finish(uint8* Dst, int64& OutWritten);
+
+	private:
+		EPSGCPCodecKernel Kernel;
+		uint32 Quantum = 0;
+		int32 QuantumCount = 0;
+		int32 PaddingCount = 0;
+		bool bClosed = false;
+		bool bFailed = false;
+	};
+};
@@ -0,0 +1,107 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+
+#define PSGCP_PROCESS_LOG_DEFAULT_RING_SIZE (1024 * 1024)
+#define PSGCP_PROCESS_LOG_DEFAULT_SEGMENT_SIZE (8 * 1024 * 1024)
+#define PSGCP_PROCESS_LOG_DEFAULT_MAX_SEGMENTS 8
+#define PSGCP_PROCESS_LOG_MAX_LINE_LENGTH (64 * 1024)
+
+/**
+ * Persistent capture of a child process output as <Folder>/<Name>.<Sequence>.log segments.
+ * Append only copies into a bounded ring; a dedicated writer thread drains it to disk, rotates segments at line
+ * boundaries and drops the oldest ones. Every segment keeps the offset of every PSGCP_PROCESS_LOG_INDEX_STRIDE'th line,
+ * so a page of lines is read with a single seek and a short scan no matter how large the log grows.
+ * Lines longer than PSGCP_PROCESS_LOG_MAX_LINE_LENGTH bytes are broken, so output without line breaks still rotates.
+ * Line numbers are global across segments and keep counting after old segments are dropped.
+ */
+class BPIXELSTREAMINGGCP_API PSGCPProcessLog
+{
+public:
+	typedef TSharedPtr<PSGCPProcessLog, ESPMode::ThreadSafe> FPtr;
+
+	//Starts a new log with a writer thread and registers it, so FindOrOpen returns the live instance.
+	static FPtr Create(
+		const FString& FolderAbsolutePath,
+		const FString& Name,
+		FString& ErrorMessage,
+		int64 MaxSegmentSize = PSGCP_PROCESS_LOG_DEFAULT_SEGMENT_SIZE,
+		int32 MaxSegments = PSGCP_PROCESS_LOG_DEFAULT_MAX_SEGMENTS,
+		int32 RingSize = PSGCP_PROCESS_LOG_DEFAULT_RING_SIZE);
+
+	//Returns a registered log or indexes an existing one from disk. Scans the segments; do not call on the game thread.
+	static FPtr FindOrOpen(const FString& FolderAbsolutePath, const FString& Name, FString& ErrorMessage);
+
+	//Names of the logs in the folder, sorted; process log names start with their creation time.
+	static void ListLogs(const FString& FolderAbsolutePath, TArray<FString>& OutNames);
+
+	//Deletes the oldest logs that are not live until at most KeepCount remain.
+	static void PruneLogs(const FString& FolderAbsolutePath, int32 KeepCount);
+
+	~PSGCPProcessLog();
+
+	//Blocks while the ring is full, which only happens when the disk cannot keep up.
+	void Append(const uint8* Data, int32 Count);
+
+	//Terminates a trailing partial line, drains and frees the ring and stops the writer thread.
+	void Close();
+
+	const FString& GetName() const { return Name; }
+
+	//Lines before OutFirstLine were dropped with their segments.
+	void GetLineRange(int64& OutFirstLine, int64& OutLineCount) const;
+
+	//Reads up to MaxLines lines starting at StartLine, clamped to the first line still on disk.
+	bool ReadLines(int64 StartLine, int32 MaxLines, int64& OutFirstLine, TArray<FString>& OutLines, FString& ErrorMessage) const;
+
+	//Case insensitive substring filter; OutNextLine is where the next call continues, or the line count when done.
+	bool FilterLines(const FString& Filter, int64 StartLine, int32 MaxResults, TArray<int64>& OutLineNumbers, TArray<FString>& OutLines, int64& OutNextLine, FString& ErrorMessage) const;
+
+private:
+	struct FSegment
+	{
+		int32 Sequence = 0;
+		int64 FirstLine = 0;
+		int64 LineCount = 0;
+		int64 IndexedSize = 0;
+		TArray<int64> Checkpoints;
+	};
+
+	PSGCPProcessLog(const FString& InFolderAbsolutePath, const FString& InName, int64 InMaxSegmentSize, int32 InMaxSegments);
+
+	FString GetSegmentPath(int32 Sequence) const;
+
+	bool OpenSegment(int32 Sequence, int64 FirstLine, FString& ErrorMessage);
+	void RunWriter();
+	void WriteBatch(const uint8* Data, int64 Count);
+	void DeleteDroppedSegments();
+
+	bool VisitLines(int64 StartLine, TFunctionRef<bool(int64 LineNumber, const ANSICHAR* Line, int32 Length)> Visitor, FString& ErrorMessage) const;
+
+	FString FolderAbsolutePath;
+	FString Name;
+	int64 MaxSegmentSize;
+	int32 MaxSegments;
+
+	mutable FCriticalSection IndexLock;
+	TArray<FSegment> Segments;
+
+	//Owned by the writer thread.
+	TUniquePtr<class IFileHandle> SegmentHandle;
+	int64 SegmentWrittenSize = 0;
+	TArray<FString> PendingDeletes;
+
+	FCriticalSection RingLock;
+	TArray<uint8> Ring;
+	uint64 RingHead = 0;
+	uint64 RingTail = 0;
+	class FEvent* DataEvent = nullptr;
+	class FEvent* SpaceEvent = nullptr;
+	class FEvent* WriterStoppedEvent = nullptr;
+
+	FThreadSafeBool bCloseRequested;
+	FThreadSafeBool bWriterRunning;
+};
@@ -0,0 +1,24 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PSGCPProcessorReleaseCommandlet.generated.h"
+
+/**
+ * Builds the releases folder the plugin processor is downloaded and patch-updated from; see PSGCPProcessorUpdater.
+ * UE4Editor-Cmd.exe Project.uproject -run=PSGCPProcessorRelease -Release=<folder> -Output=<folder> [-Previous=<folder>+<folder>]
+ * -Previous lists the earlier releases users may have installed; a patch is generated from each of them.
+ * The output folder is uploaded as is to gs://<bucket>/releases/.
+ */
+UCLASS()
+class UPSGCPProcessorReleaseCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPSGCPProcessorReleaseCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,59 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#define PSGCP_PROCESSOR_RELEASE_ZIP_NAME "ps_unreal_plugin_processor.zip"
+#define PSGCP_PROCESSOR_RELEASE_MANIFEST_NAME "ps_unreal_plugin_processor.manifest.json"
+
+/**
+ * Updates an installed plugin processor release in place of a full re-download, driven by a per-release manifest:
+ * {
+ *   "zipSize": <size of the full release zip>,
+ *   "files": [{ "path": "...", "size": N, "sha1": "<hex>", "url": "<relative to releases/>",
+ *               "patches": [{ "fromSha1": "<hex>", "size": N, "url": "<relative to releases/>" }] }]
+ * }
+ * Unchanged files are copied from the installed folder, changed files are patched against their installed version
+ * when a matching patch exists or downloaded otherwise. The result is assembled in a staging folder, verified against
+ * the manifest hashes and only then swapped with the installed folder.
+ *
+ * Patches are little endian: "PSGCPDF1", uint64 target size, then ops until 0:
+ * 1 = copy (uint64 source offset, uint64 length), 2 = insert (uint64 length, bytes).
+ *
+ * The releases folder is produced by BuildRelease through UPSGCPProcessorReleaseCommandlet:
+ * PSGCP_PROCESSOR_RELEASE_ZIP_NAME, PSGCP_PROCESSOR_RELEASE_MANIFEST_NAME, files/<path> and patches/<path>.<fromSha1>.patch.
+ */
+class BPIXELSTREAMINGGCP_API PSGCPProcessorUpdater
+{
+public:
+	//OnComplete is called once on the game thread, also when a request fails to start; on failure the installed folder is left untouched.
+	static void TryPatchUpdate(
+		const FString& ManifestUrl,
+		const FString& ReleasesBaseUrl,
+		const FString& InstalledFolderAbsolutePath,
+		const FString& StagingFolderAbsolutePath,
+		TFunction<void(bool bSucceed, const FString& ErrorMessage)> OnComplete);
+
+	//Synchronous plan and apply step of TryPatchUpdate; Fetch serves the manifest urls instead of HTTP. Used by the automation tests.
+	static bool PatchUpdateFromManifest(
+		const FString& ManifestJson,
+		const FString& InstalledFolderAbsolutePath,
+		const FString& StagingFolderAbsolutePath,
+		TFunctionRef<bool(const FString& Url, TArray<uint8>& OutContent)> Fetch,
+		FString& ErrorMessage);
+
+	//Writes the full zip, the manifest, the files and patches from every previous release into OutputFolderAbsolutePath.
+	//Patches are only listed when they are smaller than the file they produce.
+	static bool BuildRelease(
+		const FString& ReleaseFolderAbsolutePath,
+		const TArray<FString>& PreviousReleaseFolderAbsolutePaths,
+		const FString& OutputFolderAbsolutePath,
+		FString& ErrorMessage);
+
+	//Copies every run of Target found at a block of Source, located with a rolling hash; everything else is inserted.
+	static void MakeBinaryPatch(const TArray<uint8>& Source, const TArray<uint8>& Target, TArray<uint8>& OutPatch);
+
+	//ExpectedTargetSize is the size the manifest lists for the file; a patch that claims any other size is rejected.
+	static bool ApplyBinaryPatch(const TArray<uint8>& Source, const TArray<uint8>& Patch, int64 ExpectedTargetSize, TArray<uint8>& OutTarget, FString& ErrorMessage);
+};
@@ -0,0 +1,22 @@
+/// MIT License, Copyright Burak Kara, burak@burak.io, https://en.wikipedia.org/wiki/MIT_License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+
+/**
+ * Compresses a folder into a Zip64 archive entry by entry; completed entries are checkpointed to a journal file,
+ * so a cancelled or interrupted job continues from the last checkpoint on the next call with the same arguments.
+ */
+class BPIXELSTREAMINGGCP_API PSGCPResumableZip
+{
+public:
+	static bool CompressAll(
+		const FString& SourceFolderAbsolutePath,
+		const FString& ZipAbsolutePath,
+		const FString& JournalAbsolutePath,
+		const FThreadSafeBool& bCancelRequested,
+		bool& bOutCancelled,
+		FString& ErrorMessage);
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
 #include "Runtime/Engine/Public/LatentActions.h"
+#include "HAL/ThreadSafeBool.h"
 #include "PSGCPWidgetBlueprintLibrary.generated.h"
 
 USTRUCT(BlueprintType)
@@ -15,6 +16,10 @@ struct BPIXELSTREAMINGGCP_API FProcessHandleWrapper
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Google Cloud Pixel Streaming")
 	int32 ProcessID;
 
+	//Name of the on-disk log capturing the process output, empty if the log could not be created.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Google Cloud Pixel Streaming")
+	FString LogName;
+
 	FString* OnProcessReadMessage;
 
 	struct FProcHandle ProcessHandle;
@@ -96,15 +101,41 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Google Cloud Pixel Streaming", meta = (ExpandEnumAsExecs = "Exec", Latent, LatentInfo = "LatentInfo"))
 	static bool CreateHiddenProcess(FProcessHandleWrapper& ProcessHandle, FString ProgramAbsolutePath, TArray<FString> CommandlineArgs, FString& ReadMessage, int32& ExitCode, PS_GCP_PROCESS_EXEC& Exec, FLatentActionInfo LatentInfo);
 
+	//CreateHiddenProcess that also passes every chunk read from the pipe to OnOutput on the reader thread, before it reaches ReadMessage.
+	static bool CreateHiddenProcessWithOutputHook(FProcessHandleWrapper& ProcessHandle, const FString& ProgramAbsolutePath, const TArray<FString>& CommandlineArgs, FString& ReadMessage, int32& ExitCode, PS_GCP_PROCESS_EXEC& Exec, TFunction<void(const TArray<uint8>& Output)> OnOutput, FLatentActionInfo LatentInfo);
+
 	UFUNCTION(BlueprintCallable, Category = "Google Cloud Pixel Streaming")
 	static bool KillCloseHiddenProcess(const FProcessHandleWrapper& ProcessHandle);
 
+	UFUNCTION(BlueprintCallable, Category = "Google Cloud Pixel Streaming")
+	static TArray<FString> ListProcessLogs();
+
+	//Reads a page of a process log; FirstLine is StartLine clamped to the oldest line still on disk.
+	UFUNCTION(BlueprintCallable, Category = "Google Cloud Pixel Streaming", meta = (ExpandEnumAsExecs = "Exec", Latent, LatentInfo = "LatentInfo"))
+	static void ReadProcessLog(const FString& LogName, int32 StartLine, int32 MaxLines, int32& FirstLine, int32& TotalLineCount, TArray<FString>& Lines, FString& ErrorMessage, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo);
+
+	//Case insensitive; call again from NextStartLine for the next page of matches until it reaches the line count.
+	UFUNCTION(BlueprintCallable, Category = "Google Cloud Pixel Streaming", meta = (ExpandEnumAsExecs = "Exec", Latent, LatentInfo = "LatentInfo"))
+	static void FilterProcessLog(const FString& LogName, const FString& Filter, int32 StartLine, int32 MaxResults, TArray<int32>& LineNumbers, TArray<FString>& Lines, int32& NextStartLine, FString& ErrorMessage, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo);
+
 	UFUNCTION(BlueprintCallable, Category = "Google Cloud Pixel Streaming", meta = (ExpandEnumAsExecs = "Exec", Latent, LatentInfo = "LatentInfo"))
 	static bool DownloadBUnrealPSPluginProcessor(const FString& GC_BucketName, FString& ProgramAbsolutePath, FString& ErrorMessage, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo);
 
+	//bCancelled is set when the job failed because CancelZipPackagedApplicationFolder was called.
+	//Triggering the node again while its job runs is ignored; only another node fails while a job is running.
 	UFUNCTION(BlueprintCallable, Category = "Google Cloud Pixel Streaming", meta = (ExpandEnumAsExecs = "Exec", Latent, LatentInfo = "LatentInfo"))
-	static void ZipPackagedApplicationFolder(const FString& PackagedApplicationFolderAbsolutePath, FString& CompressedZipAbsolutePath, FString& ErrorMessage, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo);
+	static void ZipPackagedApplicationFolder(const FString& PackagedApplicationFolderAbsolutePath, FString& CompressedZipAbsolutePath, FString& ErrorMessage, bool& bCancelled, PS_GCP_SUCCESS_FAIL_OUT_EXEC& Exec, FLatentActionInfo LatentInfo);
+
+	//Completed entries are kept; the next ZipPackagedApplicationFolder call for the same folder continues from the last checkpoint.
+	UFUNCTION(BlueprintCallable, Category = "Google Cloud Pixel Streaming")
+	static void CancelZipPackagedApplicationFolder();
 
 private:
 	static void PrepareLatentBPExecAction(bool* InDoneIf, bool* InTriggerUndoneIf, FLatentActionInfo& LatentInfo);
+	static bool HasLatentBPExecAction(const FLatentActionInfo& LatentInfo);
+
+	static bool DownloadFullBUnrealPSPluginProcessor(const FString& GC_BucketName, bool* DoneIf, FString* ProgramAbsolutePathPtr, FString* ErrorMessagePtr, PS_GCP_SUCCESS_FAIL_OUT_EXEC* ExecPtr);
+
+	static FThreadSafeBool bZipPackagedApplicationFolderRunning;
+	static FThreadSafeBool bZipPackagedApplicationFolderCancelRequested;
 };
\ No newline at end of file